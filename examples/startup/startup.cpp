@@ -0,0 +1,184 @@
+/*
+ * Copyright(c) 2024 ZettaScale Technology and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include <cstring>
+
+#include "dds/dds.hpp"
+#include "Startup.hpp"
+
+/*
+ * The Startup example measures how long it takes to create the entities of an application
+ * with many topics. It creates a number of topics for each of the types of Startup.idl, then
+ * a writer and a reader for each of the topics, and outputs the time each of these steps took
+ * in total and per entity. Running it with increasing numbers of topics shows how the creation
+ * of entities scales.
+ */
+
+using namespace org::eclipse::cyclonedds;
+
+#define prefix "=== [Startup] "
+
+static uint32_t topicsPerType(250); /*number of topics created for each type*/
+
+static std::string partitionName("Startup example"); /*name of the partition of the readers and writers*/
+
+static int parse_args(
+    int argc,
+    char **argv)
+{
+  /*
+   * Get the program parameters
+   * Parameters: startup [topicsPerType] [partitionName]
+   */
+  if (argc == 2 && (strcmp (argv[1], "-h") == 0 || strcmp (argv[1], "--help") == 0))
+  {
+    std::cout << prefix << "Usage (parameters must be supplied in order):\n";
+    std::cout << prefix << "./startup [topicsPerType] [partitionName]\n";
+    std::cout << prefix << "Defaults:\n";
+    std::cout << prefix << "./startup 250 \"Startup example\"\n" << std::flush;
+    return EXIT_FAILURE;
+  }
+
+  if (argc > 1)
+    topicsPerType = static_cast<uint32_t>(atoi (argv[1])); /* The number of topics for each type */
+
+  if (argc > 2)
+    partitionName = argv[2]; /* The name of the partition */
+
+  std::cout << prefix << "Current parameters:\n\ttopicsPerType: " << topicsPerType << "\n\tpartitionName: " << partitionName << "\n" << std::flush;
+
+  return EXIT_SUCCESS;
+}
+
+/* The entities of all topics of one type */
+template <typename T>
+struct Entities
+{
+  std::vector<dds::topic::Topic<T>> topics;
+  std::vector<dds::pub::DataWriter<T>> writers;
+  std::vector<dds::sub::DataReader<T>> readers;
+
+  void create_topics(dds::domain::DomainParticipant &participant, const std::string &typeName)
+  {
+    for (uint32_t i = 0; i < topicsPerType; i++)
+      topics.emplace_back(participant, "Startup_" + typeName + "_" + std::to_string(i));
+  }
+
+  void create_writers(dds::pub::Publisher &publisher)
+  {
+    for (auto &topic:topics)
+      writers.emplace_back(publisher, topic);
+  }
+
+  void create_readers(dds::sub::Subscriber &subscriber)
+  {
+    for (auto &topic:topics)
+      readers.emplace_back(subscriber, topic);
+  }
+
+  void clear()
+  {
+    readers.clear();
+    writers.clear();
+    topics.clear();
+  }
+};
+
+struct AllEntities
+{
+  Entities<StartupModule::Position> position;
+  Entities<StartupModule::Status> status;
+  Entities<StartupModule::Command> command;
+  Entities<StartupModule::Heartbeat> heartbeat;
+};
+
+template <typename F>
+static void measure(const char *step, size_t count, F f)
+{
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+  std::cout << prefix << step << ": " << count << " in " << static_cast<double>(elapsed.count()) / 1000.0 << " ms"
+            << " (" << (count ? static_cast<double>(elapsed.count()) / static_cast<double>(count) : 0.0) << " us each)\n" << std::flush;
+}
+
+int main (int argc, char **argv)
+{
+  try {
+    if (parse_args(argc, argv) == EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+
+    const size_t count = 4 * static_cast<size_t>(topicsPerType);
+    AllEntities e;
+
+    auto start = std::chrono::steady_clock::now();
+
+    dds::domain::DomainParticipant participant(domain::default_id());
+
+    dds::pub::qos::PublisherQos pqos;
+    pqos << dds::core::policy::Partition(partitionName);
+    dds::pub::Publisher publisher(participant, pqos);
+
+    dds::sub::qos::SubscriberQos sqos;
+    sqos << dds::core::policy::Partition(partitionName);
+    dds::sub::Subscriber subscriber(participant, sqos);
+
+    measure("Topics", count, [&]() {
+      e.position.create_topics(participant, "Position");
+      e.status.create_topics(participant, "Status");
+      e.command.create_topics(participant, "Command");
+      e.heartbeat.create_topics(participant, "Heartbeat");
+    });
+
+    measure("Writers", count, [&]() {
+      e.position.create_writers(publisher);
+      e.status.create_writers(publisher);
+      e.command.create_writers(publisher);
+      e.heartbeat.create_writers(publisher);
+    });
+
+    /* Each reader matches the writer of its topic */
+    measure("Readers", count, [&]() {
+      e.position.create_readers(subscriber);
+      e.status.create_readers(subscriber);
+      e.command.create_readers(subscriber);
+      e.heartbeat.create_readers(subscriber);
+    });
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << prefix << "Startup took " << static_cast<double>(elapsed.count()) / 1000.0 << " ms\n" << std::flush;
+
+    measure("Deletion", 3 * count, [&]() {
+      e.position.clear();
+      e.status.clear();
+      e.command.clear();
+      e.heartbeat.clear();
+    });
+  } catch (const dds::core::Exception& e) {
+    std::cerr << "DDS exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (const std::exception& e) {
+    std::cerr << "C++ exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "Generic exception" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright(c) 2024 ZettaScale Technology and others
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v. 2.0 which is available at
+ * http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+ * v. 1.0 which is available at
+ * http://www.eclipse.org/org/documents/edl-v10.php.
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+ */
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <chrono>
+#include <iostream>
+#include <cstring>
+
+#include "dds/dds.hpp"
+#include "StartupTypes.hpp"
+#include "StartupTypesList.hpp"
+
+/*
+ * The StartupTypes measurement shows how the creation of topics scales with the number of
+ * types in an application. StartupTypes.idl is generated when configuring the example and
+ * holds a configurable number of distinct types, StartupTypesList.hpp lists their names. A
+ * topic is created for each of these types, in a number of steps, and the time each step took
+ * is output. Every type is registered with ddsc when its first topic is created, so when the
+ * time per topic grows from one step to the next, looking up the types does not scale.
+ */
+
+using namespace org::eclipse::cyclonedds;
+
+#define prefix "=== [StartupTypes] "
+
+static uint32_t steps(10); /*number of steps in which the topics are created*/
+
+static int parse_args(
+    int argc,
+    char **argv)
+{
+  /*
+   * Get the program parameters
+   * Parameters: startup_types [steps]
+   */
+  if (argc == 2 && (strcmp (argv[1], "-h") == 0 || strcmp (argv[1], "--help") == 0))
+  {
+    std::cout << prefix << "Usage (parameters must be supplied in order):\n";
+    std::cout << prefix << "./startup_types [steps]\n";
+    std::cout << prefix << "Defaults:\n";
+    std::cout << prefix << "./startup_types 10\n" << std::flush;
+    return EXIT_FAILURE;
+  }
+
+  if (argc > 1)
+    steps = static_cast<uint32_t>(atoi (argv[1])); /* The number of steps */
+
+  if (steps == 0)
+    steps = 1;
+
+  std::cout << prefix << "Current parameters:\n\tsteps: " << steps << "\n" << std::flush;
+
+  return EXIT_SUCCESS;
+}
+
+/* Creates the topic of one of the generated types, the topic is deleted with the returned pointer */
+typedef std::function<std::shared_ptr<void>(dds::domain::DomainParticipant &)> TopicCreator;
+
+#define STARTUP_TOPIC_CREATOR(T) \
+  [](dds::domain::DomainParticipant &participant) -> std::shared_ptr<void> { \
+    return std::make_shared<dds::topic::Topic<StartupTypes::T>>(participant, "StartupTypes_" #T); \
+  },
+
+static const std::vector<TopicCreator> creators = { STARTUP_TYPES(STARTUP_TOPIC_CREATOR) };
+
+template <typename F>
+static void measure(const std::string &step, size_t count, F f)
+{
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+  std::cout << prefix << step << ": " << count << " in " << static_cast<double>(elapsed.count()) / 1000.0 << " ms"
+            << " (" << (count ? static_cast<double>(elapsed.count()) / static_cast<double>(count) : 0.0) << " us each)\n" << std::flush;
+}
+
+int main (int argc, char **argv)
+{
+  try {
+    if (parse_args(argc, argv) == EXIT_FAILURE) {
+      return EXIT_FAILURE;
+    }
+
+    dds::domain::DomainParticipant participant(domain::default_id());
+    std::vector<std::shared_ptr<void>> topics;
+    topics.reserve(creators.size());
+
+    /* Each step creates the topics of the next types, while those of the previous steps exist */
+    for (uint32_t step = 0; step < steps; step++) {
+      size_t first = creators.size() * step / steps;
+      size_t last = creators.size() * (step + 1) / steps;
+      measure("Topics " + std::to_string(first) + "-" + std::to_string(last), last - first, [&]() {
+        for (size_t i = first; i < last; i++)
+          topics.push_back(creators[i](participant));
+      });
+    }
+
+    measure("Deletion", topics.size(), [&]() {
+      topics.clear();
+    });
+  } catch (const dds::core::Exception& e) {
+    std::cerr << "DDS exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (const std::exception& e) {
+    std::cerr << "C++ exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "Generic exception" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -489,6 +489,12 @@ public:
      * <i>Blocking</i><br>
      * This operation can be blocked (see @ref anchor_dds_pub_datawriter_write_blocking "write blocking").
      *
+     * <i>Batch</i><br>
+     * All samples are serialized before the first of them is written, and the samples queued by
+     * a writer that uses the dds::core::policy::WriterBatching QosPolicy are sent once the last
+     * sample is written. If writing one of the samples fails, the samples that follow it are not
+     * written.
+     *
      * @param begin An iterator pointing to the beginning of a sequence of
      *              Samples or a sequence of TopicInstances
      * @param end   An iterator pointing to the end of a sequence of
@@ -541,6 +547,12 @@ public:
      * <i>Blocking</i><br>
      * This operation can be blocked (see @ref anchor_dds_pub_datawriter_write_blocking "write blocking").
      *
+     * <i>Batch</i><br>
+     * All samples are serialized before the first of them is written, and the samples queued by
+     * a writer that uses the dds::core::policy::WriterBatching QosPolicy are sent once the last
+     * sample is written. If writing one of the samples fails, the samples that follow it are not
+     * written.
+     *
      * @param begin an iterator pointing to the beginning of a sequence of
      * TopicInstances
      * @param end an iterator pointing to the end of a sequence of
@@ -58,6 +58,17 @@ class TSuspendedPublication;
  * - dds::pub::DataWriter.unregister_instance (and its overloaded counterparts).
  * - dds::pub::DataWriter.dispose_instance (and its overloaded counterparts).
  *
+ * In Cyclone DDS the serialized updates are queued by the Publisher and written
+ * together on resume, after which each DataWriter is flushed once, so that writers
+ * with the WriterBatching QoS policy pack them in as few messages as possible.
+ * Disposing or unregistering an instance writes the queued updates first. Updates
+ * of DataWriters that write through loans are not queued.
+ * The queue can also be flushed automatically, on the number of updates, their
+ * size or their age, by suspending through the delegate of the Publisher:
+ * @code{.cpp}
+ * publisher->suspend_publications(max_samples, max_bytes, max_delay);
+ * @endcode
+ *
  * @see for more information: @ref DCPS_Modules_Publication "Publication"
  * @see dds::pub::Publisher
  */
@@ -25,8 +25,15 @@
 #include <org/eclipse/cyclonedds/topic/TopicTraits.hpp>
 #include <org/eclipse/cyclonedds/core/ScopedLock.hpp>
 #include <org/eclipse/cyclonedds/pub/AnyDataWriterDelegate.hpp>
+#include <org/eclipse/cyclonedds/pub/AsyncWriteQueue.hpp>
+#include <org/eclipse/cyclonedds/pub/SerializedLoan.hpp>
 #include <dds/dds.h>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 namespace dds {
     namespace pub {
 
@@ -72,6 +79,30 @@ public:
 
     void return_loan(T& sample);
 
+    /**
+     * @brief Loans a buffer for the serialized payload of a sample.
+     *
+     * The buffer is taken from the serdata pool of the type, which recycles the buffers of
+     * samples once ddsc no longer needs them, and is sized for the given payload. Unlike
+     * loan_sample, this works for all writers, regardless of whether they use shared memory.
+     *
+     * @param[in] size The size of the payload, excluding the encoding header.
+     *
+     * @return The loan, to be filled and passed to write.
+     */
+    org::eclipse::cyclonedds::pub::SerializedLoan loan_serialized(size_t size);
+
+    /**
+     * @brief Writes the serialized payload of a loan, taking over its buffer without copying it.
+     *
+     * The key of the sample is read from the payload.
+     *
+     * @throw dds::core::InvalidArgumentError If the loan is empty or its payload is invalid.
+     */
+    void write(org::eclipse::cyclonedds::pub::SerializedLoan&& loan);
+
+    void write(org::eclipse::cyclonedds::pub::SerializedLoan&& loan, const dds::core::Time& timestamp);
+
     void write_cdr(const org::eclipse::cyclonedds::topic::CDRBlob& sample);
 
     void write_cdr(const org::eclipse::cyclonedds::topic::CDRBlob& sample, const dds::core::Time& timestamp);
@@ -88,6 +119,10 @@ public:
 
     void write(const T& sample, const dds::core::Time& timestamp);
 
+    void write(T&& sample);
+
+    void write(T&& sample, const dds::core::Time& timestamp);
+
     void write(const T& sample, const ::dds::core::InstanceHandle& instance);
 
     void write(const T& sample,
@@ -99,6 +134,10 @@ public:
     void write(const dds::topic::TopicInstance<T>& i,
                const dds::core::Time& timestamp);
 
+    template <typename FWIterator>
+    void write(const FWIterator& begin, const FWIterator& end,
+               const dds::core::Time& timestamp);
+
     void writedispose(const T& sample);
 
     void writedispose(const T& sample, const dds::core::Time& timestamp);
@@ -158,6 +197,31 @@ public:
 
     const dds::topic::Topic<T>& topic() const;
 
+    /**
+     * @brief Makes the writes of samples asynchronous.
+     *
+     * Once enabled, writing a sample (with or without timestamp, including writedispose and the
+     * ranges of samples) only moves or copies it into a bounded queue, from which background threads
+     * serialize and write the samples in order. The other operations of the writer first wait for
+     * the queued samples to be written. Asynchronous mode lasts until the writer is closed, which
+     * writes the samples that are still queued.
+     *
+     * @param[in] config The size of the queue, the number of threads and the full queue policy.
+     *
+     * @throw dds::core::PreconditionNotMetError If the writer is already asynchronous.
+     */
+    void enable_async(const org::eclipse::cyclonedds::pub::AsyncWriterConfig& config);
+
+    /**
+     * @brief Returns the counters of the asynchronous writes, all 0 if the writer is synchronous.
+     */
+    org::eclipse::cyclonedds::pub::AsyncWriterStatistics async_statistics() const;
+
+    /**
+     * @brief Waits until the samples written asynchronously so far have been handed to ddsc.
+     */
+    virtual void wait_for_async_writes();
+
     virtual const dds::pub::Publisher& publisher() const;
 
     void listener(DataWriterListener<T>* listener,
@@ -182,8 +246,43 @@ public:
           org::eclipse::cyclonedds::core::PublicationMatchedStatusDelegate &sd);
 
 private:
+   static const T* sample_ptr(const T& sample) { return &sample; }
+   static const T* sample_ptr(const dds::topic::TopicInstance<T>& i) { return &i.sample(); }
+   static ::dds::core::InstanceHandle instance_handle(const T&) { return ::dds::core::InstanceHandle(::dds::core::null); }
+   static ::dds::core::InstanceHandle instance_handle(const dds::topic::TopicInstance<T>& i) { return i.handle(); }
+
+   /* The keys of the instances registered through this writer, so that writes with the handle
+      of one of these instances do not need to derive the key from the sample. */
+   struct registered_key {
+       ddsi_keyhash_t key;
+       bool key_md5_hashed;
+   };
+
+   void remember_instance(const ::dds::core::InstanceHandle& handle, const T& sample);
+
+   void forget_instance(const ::dds::core::InstanceHandle& handle);
+
+   bool find_instance(const ::dds::core::InstanceHandle& instance, registered_key& rk);
+
+   ddsi_serdata *serialize(const T& sample, const ::dds::core::InstanceHandle& instance);
+
+   bool write_instance(const T& sample,
+                       const ::dds::core::InstanceHandle& instance,
+                       const dds::core::Time& timestamp,
+                       bool dispose);
+
+   template <typename S>
+   bool write_async(S&& sample, const dds::core::Time& timestamp, bool dispose);
+
    dds::pub::Publisher                    pub_;
    dds::topic::Topic<T>                   topic_;
+   bool                                   write_by_key_;
+   std::mutex                             instances_mutex_;
+   std::unordered_map<dds_instance_handle_t, registered_key> instances_;
+   /* The queue of asynchronous mode is only deleted along with the writer, so that writes that
+      loaded async_ before the writer was closed can still use it; closing only shuts it down. */
+   std::unique_ptr<org::eclipse::cyclonedds::pub::AsyncWriteQueue<T>> async_queue_;
+   std::atomic<org::eclipse::cyclonedds::pub::AsyncWriteQueue<T>*> async_;
 };
 
 
@@ -110,12 +110,7 @@ template <typename FWIterator>
 void
 DataWriter<T, DELEGATE>::write(const FWIterator& begin, const FWIterator& end)
 {
-    FWIterator b = begin;
-    while(b != end)
-    {
-        this->delegate()->write(*b);
-        ++b;
-    }
+    this->delegate()->write(begin, end, dds::core::Time::invalid());
 }
 
 template <typename T, template <typename Q> class DELEGATE>
@@ -124,12 +119,7 @@ void
 DataWriter<T, DELEGATE>::write(const FWIterator& begin, const FWIterator& end,
         const dds::core::Time& timestamp)
 {
-    FWIterator b = begin;
-    while(b != end)
-    {
-        this->delegate()->write(*b, timestamp);
-        ++b;
-    }
+    this->delegate()->write(begin, end, timestamp);
 }
 
 template <typename T, template <typename Q> class DELEGATE>
@@ -361,13 +351,17 @@ DataWriter<T, DELEGATE>::listener() const
 #include <dds/pub/AnyDataWriter.hpp>
 #include <dds/pub/DataWriterListener.hpp>
 #include <org/eclipse/cyclonedds/pub/AnyDataWriterDelegate.hpp>
+#include <org/eclipse/cyclonedds/topic/serdata_pool.hpp>
+#include <org/eclipse/cyclonedds/topic/datatopic.hpp>
+
+#include <vector>
 
 template <typename T>
 dds::pub::detail::DataWriter<T>::DataWriter(
     const dds::pub::Publisher& pub,
     const ::dds::topic::Topic<T>& topic,
     const dds::pub::qos::DataWriterQos& qos)
-    : ::org::eclipse::cyclonedds::pub::AnyDataWriterDelegate(qos, topic), pub_(pub), topic_(topic)
+    : ::org::eclipse::cyclonedds::pub::AnyDataWriterDelegate(qos, topic), pub_(pub), topic_(topic), write_by_key_(false), async_(nullptr)
 {
     DDSCXX_WARNING_MSVC_OFF(6326)
     if (dds::topic::is_topic_type<T>::value == 0) {
@@ -391,6 +385,22 @@ dds::pub::detail::DataWriter<T>::DataWriter(
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ddsc_writer, "Could not create DataWriter.");
     topic_.delegate()->incrNrDependents();
 
+    /* Samples are serialized with the sertype of the writer, which is derived from that of the
+       topic for the data representation of the writer. */
+    this->set_ser_type(ddsc_writer);
+
+    org::eclipse::cyclonedds::topic::serdata_pool<T>::instance().reserve(
+        dwQos.policy<dds::core::policy::ResourceLimits>().max_samples());
+
+    /* Samples of writers that use shared memory are written through loans, for which ddsc
+       derives the key itself. */
+    write_by_key_ = !AnyDataWriterDelegate::is_loan_supported(ddsc_writer);
+
+    /* While the publisher is suspended the updates of the writer are queued by the publisher,
+       except for those written through loans. */
+    if (write_by_key_)
+        this->publication_queue(pub.delegate()->publication_queue());
+
     this->set_ddsc_entity(ddsc_writer);
 }
 
@@ -449,11 +459,47 @@ dds::pub::detail::DataWriter<T>::return_loan(T& sample)
     AnyDataWriterDelegate::return_loan(static_cast<dds_entity_t>(this->ddsc_entity), &sample);
 }
 
+template <typename T>
+org::eclipse::cyclonedds::pub::SerializedLoan
+dds::pub::detail::DataWriter<T>::loan_serialized(size_t size)
+{
+    this->check();
+    unsigned char *payload;
+    org::eclipse::cyclonedds::pub::SerializedLoan::encoding_version encoding;
+    ddsi_serdata *sd = serdata_loan<T>(this->get_ser_type(), size, payload, encoding);
+    return org::eclipse::cyclonedds::pub::SerializedLoan(sd, payload, size, encoding);
+}
+
+template <typename T>
+void
+dds::pub::detail::DataWriter<T>::write(org::eclipse::cyclonedds::pub::SerializedLoan&& loan)
+{
+    this->write(std::move(loan), dds::core::Time::invalid());
+}
+
+template <typename T>
+void
+dds::pub::detail::DataWriter<T>::write(
+    org::eclipse::cyclonedds::pub::SerializedLoan&& loan,
+    const dds::core::Time& timestamp)
+{
+    this->check();
+    if (!loan)
+        ISOCPP_THROW_EXCEPTION(ISOCPP_INVALID_ARGUMENT_ERROR, "Loan holds no buffer.");
+    this->wait_for_async_writes();
+
+    /* The loan keeps the buffer if its payload is rejected, so that it is returned to the pool. */
+    if (!serdata_from_loan<T>(loan.serdata_, loan.size()))
+        ISOCPP_THROW_EXCEPTION(ISOCPP_INVALID_ARGUMENT_ERROR, "Could not read the key from the serialized payload.");
+    AnyDataWriterDelegate::write_serdata(static_cast<dds_entity_t>(this->ddsc_entity), loan.release(), timestamp);
+}
+
 template <typename T>
 void
 dds::pub::detail::DataWriter<T>::write_cdr(const org::eclipse::cyclonedds::topic::CDRBlob& sample)
 {
     this->check();
+    this->wait_for_async_writes();
     AnyDataWriterDelegate::write_cdr(static_cast<dds_entity_t>(this->ddsc_entity),
                                   &sample,
                                   dds::core::InstanceHandle(dds::core::null),
@@ -467,6 +513,7 @@ dds::pub::detail::DataWriter<T>::write_cdr(
             const dds::core::Time& timestamp)
 {
     this->check();
+    this->wait_for_async_writes();
     AnyDataWriterDelegate::write_cdr(static_cast<dds_entity_t>(this->ddsc_entity),
                                   &sample,
                                   dds::core::InstanceHandle(dds::core::null),
@@ -478,6 +525,7 @@ void
 dds::pub::detail::DataWriter<T>::dispose_cdr(const org::eclipse::cyclonedds::topic::CDRBlob& sample)
 {
     this->check();
+    this->wait_for_async_writes();
     AnyDataWriterDelegate::dispose_cdr(static_cast<dds_entity_t>(this->ddsc_entity),
                                   &sample,
                                   dds::core::InstanceHandle(dds::core::null),
@@ -491,6 +539,7 @@ dds::pub::detail::DataWriter<T>::dispose_cdr(
             const dds::core::Time& timestamp)
 {
     this->check();
+    this->wait_for_async_writes();
     AnyDataWriterDelegate::dispose_cdr(static_cast<dds_entity_t>(this->ddsc_entity),
                                   &sample,
                                   dds::core::InstanceHandle(dds::core::null),
@@ -502,6 +551,7 @@ void
 dds::pub::detail::DataWriter<T>::unregister_instance_cdr(const org::eclipse::cyclonedds::topic::CDRBlob& sample)
 {
     this->check();
+    this->wait_for_async_writes();
     AnyDataWriterDelegate::unregister_instance_cdr(static_cast<dds_entity_t>(this->ddsc_entity),
                                   &sample,
                                   dds::core::InstanceHandle(dds::core::null),
@@ -515,6 +565,7 @@ dds::pub::detail::DataWriter<T>::unregister_instance_cdr(
             const dds::core::Time& timestamp)
 {
     this->check();
+    this->wait_for_async_writes();
     AnyDataWriterDelegate::unregister_instance_cdr(static_cast<dds_entity_t>(this->ddsc_entity),
                                   &sample,
                                   dds::core::InstanceHandle(dds::core::null),
@@ -526,6 +577,8 @@ void
 dds::pub::detail::DataWriter<T>::write(const T& sample)
 {
     this->check();
+    if (this->write_async(sample, dds::core::Time::invalid(), false))
+        return;
     AnyDataWriterDelegate::write(static_cast<dds_entity_t>(this->ddsc_entity),
                                   &sample,
                                   dds::core::InstanceHandle(dds::core::null),
@@ -537,6 +590,34 @@ void
 dds::pub::detail::DataWriter<T>::write(const T& sample, const dds::core::Time& timestamp)
 {
     this->check();
+    if (this->write_async(sample, timestamp, false))
+        return;
+    AnyDataWriterDelegate::write(static_cast<dds_entity_t>(this->ddsc_entity),
+                                  &sample,
+                                  dds::core::InstanceHandle(dds::core::null),
+                                  timestamp);
+}
+
+template <typename T>
+void
+dds::pub::detail::DataWriter<T>::write(T&& sample)
+{
+    this->check();
+    if (this->write_async(std::move(sample), dds::core::Time::invalid(), false))
+        return;
+    AnyDataWriterDelegate::write(static_cast<dds_entity_t>(this->ddsc_entity),
+                                  &sample,
+                                  dds::core::InstanceHandle(dds::core::null),
+                                  dds::core::Time::invalid());
+}
+
+template <typename T>
+void
+dds::pub::detail::DataWriter<T>::write(T&& sample, const dds::core::Time& timestamp)
+{
+    this->check();
+    if (this->write_async(std::move(sample), timestamp, false))
+        return;
     AnyDataWriterDelegate::write(static_cast<dds_entity_t>(this->ddsc_entity),
                                   &sample,
                                   dds::core::InstanceHandle(dds::core::null),
@@ -548,6 +629,9 @@ void
 dds::pub::detail::DataWriter<T>::write(const T& sample, const ::dds::core::InstanceHandle& instance)
 {
     this->check();
+    this->wait_for_async_writes();
+    if (this->write_instance(sample, instance, dds::core::Time::invalid(), false))
+        return;
     AnyDataWriterDelegate::write(static_cast<dds_entity_t>(this->ddsc_entity),
                                   &sample,
                                   instance,
@@ -561,6 +645,9 @@ dds::pub::detail::DataWriter<T>::write(const T& sample,
            const dds::core::Time& timestamp)
 {
     this->check();
+    this->wait_for_async_writes();
+    if (this->write_instance(sample, instance, timestamp, false))
+        return;
     AnyDataWriterDelegate::write(static_cast<dds_entity_t>(this->ddsc_entity),
                                   &sample,
                                   instance,
@@ -572,6 +659,9 @@ void
 dds::pub::detail::DataWriter<T>::write(const dds::topic::TopicInstance<T>& i)
 {
     this->check();
+    this->wait_for_async_writes();
+    if (this->write_instance(i.sample(), i.handle(), dds::core::Time::invalid(), false))
+        return;
     AnyDataWriterDelegate::write(static_cast<dds_entity_t>(this->ddsc_entity),
                                   &i.sample(),
                                   i.handle(),
@@ -584,17 +674,217 @@ dds::pub::detail::DataWriter<T>::write(const dds::topic::TopicInstance<T>& i,
            const dds::core::Time& timestamp)
 {
     this->check();
+    this->wait_for_async_writes();
+    if (this->write_instance(i.sample(), i.handle(), timestamp, false))
+        return;
     AnyDataWriterDelegate::write(static_cast<dds_entity_t>(this->ddsc_entity),
                                   &i.sample(),
                                   i.handle(),
                                   timestamp);
 }
 
+template <typename T>
+template <typename FWIterator>
+void
+dds::pub::detail::DataWriter<T>::write(const FWIterator& begin, const FWIterator& end,
+        const dds::core::Time& timestamp)
+{
+    this->check();
+
+    org::eclipse::cyclonedds::pub::AsyncWriteQueue<T> *queue = this->async_.load(std::memory_order_acquire);
+    if (queue != nullptr) {
+        for (FWIterator b = begin; b != end; ++b)
+            queue->push(*sample_ptr(*b), timestamp, false, instance_handle(*b));
+        return;
+    }
+
+    /* Writers that use shared memory write the samples through loans, one at a time. */
+    if (!write_by_key_) {
+        for (FWIterator b = begin; b != end; ++b)
+            AnyDataWriterDelegate::write(static_cast<dds_entity_t>(this->ddsc_entity),
+                                          sample_ptr(*b),
+                                          instance_handle(*b),
+                                          timestamp);
+        return;
+    }
+
+    /* Serialize all samples before handing them to ddsc, so that serialization does not
+       interleave with the work ddsc does for each of them. */
+    std::vector<ddsi_serdata *> batch;
+    try {
+        for (FWIterator b = begin; b != end; ++b)
+            batch.push_back(this->serialize(*sample_ptr(*b), instance_handle(*b)));
+    } catch (...) {
+        for (auto sd:batch)
+            ddsi_serdata_unref(sd);
+        throw;
+    }
+
+    if (!batch.empty())
+        AnyDataWriterDelegate::write_batch(static_cast<dds_entity_t>(this->ddsc_entity),
+                                      batch.data(),
+                                      batch.size(),
+                                      timestamp);
+}
+
+template <typename T>
+void
+dds::pub::detail::DataWriter<T>::remember_instance(const ::dds::core::InstanceHandle& handle, const T& sample)
+{
+    if (!write_by_key_ || handle.is_nil())
+        return;
+
+    registered_key rk;
+    rk.key_md5_hashed = to_key(sample, rk.key);
+
+    std::lock_guard<std::mutex> lock(instances_mutex_);
+    instances_[handle.delegate().handle()] = rk;
+}
+
+template <typename T>
+void
+dds::pub::detail::DataWriter<T>::forget_instance(const ::dds::core::InstanceHandle& handle)
+{
+    if (handle.is_nil())
+        return;
+
+    std::lock_guard<std::mutex> lock(instances_mutex_);
+    instances_.erase(handle.delegate().handle());
+}
+
+template <typename T>
+bool
+dds::pub::detail::DataWriter<T>::find_instance(const ::dds::core::InstanceHandle& instance, registered_key& rk)
+{
+    if (instance.is_nil())
+        return false;
+
+    std::lock_guard<std::mutex> lock(instances_mutex_);
+    auto it = instances_.find(instance.delegate().handle());
+    if (it == instances_.end())
+        return false;
+    rk = it->second;
+    return true;
+}
+
+template <typename T>
+ddsi_serdata *
+dds::pub::detail::DataWriter<T>::serialize(const T& sample, const ::dds::core::InstanceHandle& instance)
+{
+    /* Samples of registered instances take their key from the registration, like write_instance. */
+    registered_key rk;
+    ddsi_serdata *sd;
+    if (this->find_instance(instance, rk))
+        sd = serdata_from_sample_and_key<T>(this->get_ser_type(), sample, rk.key, rk.key_md5_hashed);
+    else
+        sd = ddsi_serdata_from_sample(this->get_ser_type(), SDK_DATA, &sample);
+    if (sd == nullptr)
+        ISOCPP_THROW_EXCEPTION(ISOCPP_ERROR, "write failed: could not serialize sample.");
+    return sd;
+}
+
+template <typename T>
+bool
+dds::pub::detail::DataWriter<T>::write_instance(
+           const T& sample,
+           const ::dds::core::InstanceHandle& instance,
+           const dds::core::Time& timestamp,
+           bool dispose)
+{
+    if (!write_by_key_ || instance.is_nil())
+        return false;
+
+    registered_key rk;
+    if (!this->find_instance(instance, rk))
+        return false;
+
+    /* The handle identifies the instance, so the key is taken from its registration rather than
+       from the sample, the two are only compared in debug builds. */
+    ddsi_serdata *sd = serdata_from_sample_and_key<T>(this->get_ser_type(), sample, rk.key, rk.key_md5_hashed);
+    if (sd == nullptr)
+        ISOCPP_THROW_EXCEPTION(ISOCPP_ERROR, "Could not serialize sample.");
+
+    if (dispose)
+        AnyDataWriterDelegate::writedispose_serdata(static_cast<dds_entity_t>(this->ddsc_entity), sd, timestamp);
+    else
+        AnyDataWriterDelegate::write_serdata(static_cast<dds_entity_t>(this->ddsc_entity), sd, timestamp);
+    return true;
+}
+
+template <typename T>
+template <typename S>
+bool
+dds::pub::detail::DataWriter<T>::write_async(S&& sample, const dds::core::Time& timestamp, bool dispose)
+{
+    org::eclipse::cyclonedds::pub::AsyncWriteQueue<T> *queue = this->async_.load(std::memory_order_acquire);
+    if (queue == nullptr)
+        return false;
+    queue->push(std::forward<S>(sample), timestamp, dispose);
+    return true;
+}
+
+template <typename T>
+void
+dds::pub::detail::DataWriter<T>::enable_async(const org::eclipse::cyclonedds::pub::AsyncWriterConfig& config)
+{
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+    this->check();
+    if (this->async_queue_)
+        ISOCPP_THROW_EXCEPTION(ISOCPP_PRECONDITION_NOT_MET_ERROR, "Writer is already asynchronous.");
+
+    const dds_entity_t writer = static_cast<dds_entity_t>(this->ddsc_entity);
+    const bool by_key = this->write_by_key_;
+
+    /* Samples of writers that write through loans are handed to ddsc as they are, samples of
+       registered instances take their key from the registration, as in a synchronous write. */
+    auto serialize_fn = [this, by_key](const T& sample, const dds::core::InstanceHandle& instance) -> ddsi_serdata* {
+        if (!by_key)
+            return nullptr;
+        return this->serialize(sample, instance);
+    };
+    auto submit_fn = [this, writer](const T& sample, ddsi_serdata *sd, const dds::core::InstanceHandle& instance,
+                                    const dds::core::Time& timestamp, bool dispose) {
+        if (sd == nullptr && dispose)
+            this->AnyDataWriterDelegate::writedispose(writer, &sample, instance, timestamp);
+        else if (sd == nullptr)
+            this->AnyDataWriterDelegate::write(writer, &sample, instance, timestamp);
+        else if (dispose)
+            this->AnyDataWriterDelegate::writedispose_serdata(writer, sd, timestamp);
+        else
+            this->AnyDataWriterDelegate::write_serdata(writer, sd, timestamp);
+    };
+
+    this->async_queue_.reset(new org::eclipse::cyclonedds::pub::AsyncWriteQueue<T>(config, serialize_fn, submit_fn));
+    this->async_.store(this->async_queue_.get(), std::memory_order_release);
+}
+
+template <typename T>
+org::eclipse::cyclonedds::pub::AsyncWriterStatistics
+dds::pub::detail::DataWriter<T>::async_statistics() const
+{
+    this->check();
+    org::eclipse::cyclonedds::pub::AsyncWriteQueue<T> *queue = this->async_.load(std::memory_order_acquire);
+    if (queue == nullptr)
+        return org::eclipse::cyclonedds::pub::AsyncWriterStatistics();
+    return queue->statistics();
+}
+
+template <typename T>
+void
+dds::pub::detail::DataWriter<T>::wait_for_async_writes()
+{
+    org::eclipse::cyclonedds::pub::AsyncWriteQueue<T> *queue = this->async_.load(std::memory_order_acquire);
+    if (queue != nullptr)
+        queue->drain();
+}
+
 template <typename T>
 void
 dds::pub::detail::DataWriter<T>::writedispose(const T& sample)
 {
     this->check();
+    if (this->write_async(sample, dds::core::Time::invalid(), true))
+        return;
     AnyDataWriterDelegate::writedispose(
                                   static_cast<dds_entity_t>(this->ddsc_entity),
                                   &sample,
@@ -607,6 +897,8 @@ void
 dds::pub::detail::DataWriter<T>::writedispose(const T& sample, const dds::core::Time& timestamp)
 {
     this->check();
+    if (this->write_async(sample, timestamp, true))
+        return;
     AnyDataWriterDelegate::writedispose(
                                   static_cast<dds_entity_t>(this->ddsc_entity),
                                   &sample,
@@ -619,6 +911,9 @@ void
 dds::pub::detail::DataWriter<T>::writedispose(const T& sample, const ::dds::core::InstanceHandle& instance)
 {
     this->check();
+    this->wait_for_async_writes();
+    if (this->write_instance(sample, instance, dds::core::Time::invalid(), true))
+        return;
     AnyDataWriterDelegate::writedispose(
                                   static_cast<dds_entity_t>(this->ddsc_entity),
                                   &sample,
@@ -634,6 +929,9 @@ dds::pub::detail::DataWriter<T>::writedispose(
            const dds::core::Time& timestamp)
 {
     this->check();
+    this->wait_for_async_writes();
+    if (this->write_instance(sample, instance, timestamp, true))
+        return;
     AnyDataWriterDelegate::writedispose(
                                   static_cast<dds_entity_t>(this->ddsc_entity),
                                   &sample,
@@ -646,6 +944,9 @@ void
 dds::pub::detail::DataWriter<T>::writedispose(const dds::topic::TopicInstance<T>& i)
 {
     this->check();
+    this->wait_for_async_writes();
+    if (this->write_instance(i.sample(), i.handle(), dds::core::Time::invalid(), true))
+        return;
     AnyDataWriterDelegate::writedispose(
                                   static_cast<dds_entity_t>(this->ddsc_entity),
                                   &i.sample(),
@@ -660,6 +961,9 @@ dds::pub::detail::DataWriter<T>::writedispose(
            const dds::core::Time& timestamp)
 {
     this->check();
+    this->wait_for_async_writes();
+    if (this->write_instance(i.sample(), i.handle(), timestamp, true))
+        return;
     AnyDataWriterDelegate::writedispose(
                                   static_cast<dds_entity_t>(this->ddsc_entity),
                                   &i.sample(),
@@ -742,7 +1046,9 @@ dds::pub::detail::DataWriter<T>::register_instance(const T& key,
 {
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
     this->check();
+    this->wait_for_async_writes();
     dds::core::InstanceHandle handle(AnyDataWriterDelegate::register_instance(static_cast<dds_entity_t>(this->ddsc_entity), &key, timestamp));
+    this->remember_instance(handle, key);
     return handle;
 }
 
@@ -753,7 +1059,9 @@ dds::pub::detail::DataWriter<T>::unregister_instance(const ::dds::core::Instance
 {
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
     this->check();
+    this->wait_for_async_writes();
     AnyDataWriterDelegate::unregister_instance(static_cast<dds_entity_t>(this->ddsc_entity), handle, timestamp);
+    this->forget_instance(handle);
 }
 
 template <typename T>
@@ -763,6 +1071,9 @@ dds::pub::detail::DataWriter<T>::unregister_instance(const T& sample,
 {
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
     this->check();
+    this->wait_for_async_writes();
+    if (write_by_key_)
+        this->forget_instance(dds::core::InstanceHandle(AnyDataWriterDelegate::lookup_instance(static_cast<dds_entity_t>(this->ddsc_entity), &sample)));
     AnyDataWriterDelegate::unregister_instance(static_cast<dds_entity_t>(this->ddsc_entity), &sample, timestamp);
 }
 
@@ -773,6 +1084,7 @@ dds::pub::detail::DataWriter<T>::dispose_instance(const ::dds::core::InstanceHan
 {
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
     this->check();
+    this->wait_for_async_writes();
     AnyDataWriterDelegate::dispose_instance(static_cast<dds_entity_t>(this->ddsc_entity), handle, timestamp);
 }
 
@@ -783,6 +1095,7 @@ dds::pub::detail::DataWriter<T>::dispose_instance(const T& sample,
 {
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
     this->check();
+    this->wait_for_async_writes();
     AnyDataWriterDelegate::dispose_instance(static_cast<dds_entity_t>(this->ddsc_entity), &sample, timestamp);
 }
 
@@ -817,7 +1130,9 @@ dds::pub::detail::DataWriter<T>::lookup_instance(const T& key)
 {
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
     this->check();
+    this->wait_for_async_writes();
     dds::core::InstanceHandle handle(AnyDataWriterDelegate::lookup_instance(static_cast<dds_entity_t>(this->ddsc_entity), &key));
+    this->remember_instance(handle, key);
     return handle;
 }
 
@@ -862,6 +1177,17 @@ template <typename T>
 void
 dds::pub::detail::DataWriter<T>::close()
 {
+    /* The samples that are still queued are written before the writer is deleted. The queue
+       itself lives as long as the writer, so writes that still use it refer to a queue that
+       refuses them, and it is drained without the lock, as the writes may invoke listeners. */
+    org::eclipse::cyclonedds::pub::AsyncWriteQueue<T> *queue;
+    {
+        org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+        queue = this->async_.exchange(nullptr, std::memory_order_acq_rel);
+    }
+    if (queue != nullptr)
+        queue->shutdown();
+
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
 
     this->listener_set(NULL, dds::core::status::StatusMask::none(), true);
@@ -40,7 +40,11 @@ void TSuspendedPublication<DELEGATE>::resume()
 template <typename DELEGATE>
 TSuspendedPublication<DELEGATE>::~TSuspendedPublication()
 {
-    this->delegate().resume();
+    try {
+        this->delegate().resume();
+    } catch (...) {
+        /* Empty: the exception throw should have already traced an error. */
+    }
 }
 
 }
@@ -68,6 +68,23 @@ public:
 
     bool is_loan_supported();
 
+    /**
+     * @brief Deserializes received samples into recycled samples.
+     *
+     * At most max_samples samples of data that is no longer referenced are kept, and data received
+     * later is deserialized into them, reusing the memory of their strings and sequences. The kept
+     * samples are shared by all readers of T in the process, so this applies to all of them. A value
+     * of 0, the default, disables recycling. Types that are not recyclable are never recycled.
+     *
+     * @param[in] max_samples The maximum number of unused samples kept.
+     */
+    void sample_recycling(size_t max_samples);
+
+    /**
+     * @brief Returns the maximum number of unused samples kept for recycling, 0 if disabled.
+     */
+    size_t sample_recycling() const;
+
     dds::sub::LoanedSamples<org::eclipse::cyclonedds::topic::CDRBlob> read_cdr();
     dds::sub::LoanedSamples<org::eclipse::cyclonedds::topic::CDRBlob> take_cdr();
 
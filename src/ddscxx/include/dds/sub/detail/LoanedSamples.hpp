@@ -80,6 +80,17 @@ public:
         samples_.push_back(s);
     }
 
+    /**
+     * Returns a view on the data of sample i, which only deserializes the members that are accessed.
+     *
+     * Only available for types for which idlcxx generated views (-f views).
+     */
+    template <typename V = typename org::eclipse::cyclonedds::topic::view_traits<T>::type>
+    V view(uint32_t i) const
+    {
+        return this->samples_[i].delegate().template view<V>();
+    }
+
 
 private:
     LoanedSamplesContainer samples_;
@@ -30,6 +30,7 @@ class SampleRef;
 
 #include <dds/sub/SampleInfo.hpp>
 #include <org/eclipse/cyclonedds/topic/datatopic.hpp>
+#include <org/eclipse/cyclonedds/topic/sample_view.hpp>
 
 namespace dds
 {
@@ -83,6 +84,21 @@ public:
       return *data_->getT();
     }
 
+    /**
+     * Returns a view on the data, which only deserializes the members that are accessed.
+     *
+     * Only available for types for which idlcxx generated views (-f views).
+     */
+    template <typename V = typename org::eclipse::cyclonedds::topic::view_traits<T>::type>
+    V view() const
+    {
+      if (data_ == nullptr)
+      {
+          throw dds::core::Error("Data is Null");
+      }
+      return V(data_);
+    }
+
     const dds::sub::SampleInfo& info() const
     {
         return info_;
@@ -141,13 +141,28 @@ public:
     }
 
     void append_sample(void *sample, const dds_sample_info_t *si)
+    {
+        add_sample(sample, si, false);
+    }
+
+    void take_sample(void *sample, const dds_sample_info_t *si)
+    {
+        add_sample(sample, si, true);
+    }
+
+private:
+    void add_sample(void *sample, const dds_sample_info_t *si, bool take)
     {
         ddscxx_serdata<T>* sd = static_cast<ddscxx_serdata<T>*>(sample);
-        (iterator++)->delegate() = dds::sub::detail::Sample<T>(*sd->getT(), sample_info_from_c(si));
+        auto &s = iterator->delegate();
+        //a sample that cannot be deserialized is skipped, exceptions cannot pass through ddsc
+        if (!sd->extractT(s.data(), take))
+            return;
+        s.info(sample_info_from_c(si));
+        ++iterator;
         ++size;
     }
 
-private:
     SamplesFWIterator& iterator;
     uint32_t size;
 
@@ -172,16 +187,27 @@ public:
     }
 
     void append_sample(void *sample, const dds_sample_info_t *si)
+    {
+        add_sample(sample, si, false);
+    }
+
+    void take_sample(void *sample, const dds_sample_info_t *si)
+    {
+        add_sample(sample, si, true);
+    }
+
+private:
+    void add_sample(void *sample, const dds_sample_info_t *si, bool take)
     {
         ddscxx_serdata<T>* sd = static_cast<ddscxx_serdata<T>*>(sample);
-        last_sample.delegate().data() = *sd->getT();
+        if (!sd->extractT(last_sample.delegate().data(), take))
+            return;
         last_sample.delegate().info(sample_info_from_c(si));
         iterator = std::move(last_sample);
         ++iterator;
         ++size;
     }
 
-private:
     SamplesBIIterator& iterator;
     dds::sub::Sample<T> last_sample;
     uint32_t size;
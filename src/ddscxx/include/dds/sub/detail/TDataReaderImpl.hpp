@@ -450,6 +450,8 @@ DataReader<T, DELEGATE>::listener() const
 #include <dds/topic/ContentFilteredTopic.hpp>
 #include <org/eclipse/cyclonedds/sub/AnyDataReaderDelegate.hpp>
 #include <org/eclipse/cyclonedds/core/ListenerDispatcher.hpp>
+#include <org/eclipse/cyclonedds/topic/serdata_pool.hpp>
+#include <org/eclipse/cyclonedds/topic/sample_pool.hpp>
 
 
 template <typename T>
@@ -505,6 +507,9 @@ dds::sub::detail::DataReader<T>::common_constructor()
 
     this->AnyDataReaderDelegate::td_.delegate()->incrNrDependents();
 
+    org::eclipse::cyclonedds::topic::serdata_pool<T>::instance().reserve(
+        drQos.policy<dds::core::policy::ResourceLimits>().max_samples());
+
     this->AnyDataReaderDelegate::setSample(&this->typed_sample_);
     this->set_ddsc_entity(ddsc_reader);
 }
@@ -567,6 +572,22 @@ dds::sub::detail::DataReader<T>::is_loan_supported()
   return this->AnyDataReaderDelegate::is_loan_supported(static_cast<dds_entity_t>(this->ddsc_entity));
 }
 
+template <typename T>
+void
+dds::sub::detail::DataReader<T>::sample_recycling(size_t max_samples)
+{
+  this->check();
+  org::eclipse::cyclonedds::topic::sample_pool<T>::instance().capacity(max_samples);
+}
+
+template <typename T>
+size_t
+dds::sub::detail::DataReader<T>::sample_recycling() const
+{
+  this->check();
+  return org::eclipse::cyclonedds::topic::sample_pool<T>::instance().capacity();
+}
+
 template <typename T>
 dds::sub::LoanedSamples<org::eclipse::cyclonedds::topic::CDRBlob>
 dds::sub::detail::DataReader<T>::read_cdr()
@@ -16,6 +16,7 @@
 #include <org/eclipse/cyclonedds/core/cdr/entity_properties.hpp>
 #include <stdint.h>
 #include <string>
+#include <algorithm>
 #include <stdexcept>
 #include <stack>
 #include <cassert>
@@ -62,6 +63,19 @@ class custom_stack {
 template<typename E>
 E enum_conversion(uint32_t in);
 
+/**
+ * @brief
+ * Enum contiguous value bound function template.
+ *
+ * This function is specialized for each enumerated class whose enumerators have the
+ * values 0 up to the number of enumerators, so any value below the returned bound
+ * can be cast to the enum directly, instead of going through enum_conversion.
+ *
+ * @return The number of enumerators, or 0 if the enumerator values are not contiguous.
+ */
+template<typename E>
+constexpr uint32_t enum_bound() { return 0; }
+
 /**
  * @brief
  * Byte swapping function, is only enabled for arithmetic (base) types of size 1.
@@ -122,6 +136,21 @@ inline void byte_swap(T* toswap) noexcept {
     std::swap(*u1, *u2);
 }
 
+/**
+ * @brief
+ * Byte swapping copy function, for arrays of entities of size 1, 2, 4 or 8.
+ *
+ * Copies N entities from src to dst, swapping the bytes of each entity in the same pass.
+ * Uses the widest vector instructions available on the cpu, this is determined on the first call.
+ * The buffers do not need to be aligned, but must not overlap.
+ *
+ * @param[out] dst The buffer to copy to.
+ * @param[in] src The buffer to copy from.
+ * @param[in] N The number of entities to copy.
+ * @param[in] size The size of each entity.
+ */
+OMG_DDS_API void byte_swap_copy(void *dst, const void *src, size_t N, size_t size) noexcept;
+
 /**
  * @brief
  * Endianness types.
@@ -506,6 +535,25 @@ public:
      */
     virtual bool finish_consecutive() {return true;}
 
+    /**
+     * @brief
+     * Function declaration for starting a member in the straight-line streaming functions of final types.
+     *
+     * These functions do not call start_member and finish_member, and no member headers are necessary.
+     * This function only marks the start of the member for the bookkeeping of consecutive entities.
+     * It is not virtual, as the generated functions are templated on the streamer type, and is an
+     * effective no-op for all streamers except xcdr_v2.
+     */
+    void start_member_scope() {;}
+
+    /**
+     * @brief
+     * Function declaration for finishing a member in the straight-line streaming functions of final types.
+     *
+     * This function is an effective no-op for all streamers except xcdr_v2.
+     */
+    void finish_member_scope() {;}
+
 protected:
 
     /**
@@ -591,6 +639,8 @@ protected:
  * Aligns the stream to the alignment of type T.
  * Reads the value from the current position of the stream str into
  * toread, will swap bytes if necessary.
+ * Arrays of entities are swapped while they are copied, using byte_swap_copy.
+ * Booleans are checked to be encoded as 0 or 1, as in read_bool_sequence.
  * Moves the cursor of the stream by the size of T.
  * This function is only enabled for arithmetic types and enums.
  *
@@ -610,15 +660,28 @@ bool read(S &str, T& toread, size_t N = 1)
     return false;
 
   T* to = &toread;
-  if (N > 1 || sizeof(T) > 4) {
-    memcpy(reinterpret_cast<void*>(to),reinterpret_cast<const void*>(str.get_cursor()),sizeof(T)*N);
+  if (std::is_same<T, bool>::value) {
+    auto from = reinterpret_cast<const uint8_t*>(str.get_cursor());
+    uint8_t all_bits = 0;
+    for (size_t i = 0; i < N; i++) {
+      all_bits |= from[i];
+      to[i] = from[i] != 0;
+    }
+
+    if (all_bits > 1
+     && str.status(serialization_status::illegal_field_value))
+      return false;
+  } else if (N > 1 && sizeof(T) > 1 && str.swap_endianness()) {
+    byte_swap_copy(reinterpret_cast<void*>(to),reinterpret_cast<const void*>(str.get_cursor()),N,sizeof(T));
   } else {
-    const T* from = reinterpret_cast<const T*>(str.get_cursor());
-    *to = *from;
-  }
-
-  if (sizeof(T) > 1 && str.swap_endianness()) {
-    for (size_t i = 0; i < N; i++, to++)
+    if (N > 1 || sizeof(T) > 4) {
+      memcpy(reinterpret_cast<void*>(to),reinterpret_cast<const void*>(str.get_cursor()),sizeof(T)*N);
+    } else {
+      const T* from = reinterpret_cast<const T*>(str.get_cursor());
+      *to = *from;
+    }
+
+    if (N == 1 && sizeof(T) > 1 && str.swap_endianness())
       byte_swap(to);
   }
 
@@ -633,8 +696,9 @@ bool read(S &str, T& toread, size_t N = 1)
  *
  * Uses the template parameter I to determine the stream-end read type,
  * this type is determined by the stream implementation.
- * Reads the enums as type I from the stream.
- * Each read entity is verified by the enum's conversion version.
+ * Reads the enums as type I from the stream, in blocks of at most 64 entities.
+ * If all entities in a block are below the enum's bound, they are cast directly,
+ * otherwise each read entity is verified by the enum's conversion version.
  * This function is only enabled for enum types.
  *
  * @param[in, out] str The stream which is read from.
@@ -648,13 +712,30 @@ template<typename S, typename T, typename I, std::enable_if_t<std::is_integral<I
                                                && std::is_base_of<cdr_stream, S>::value, bool> = true>
 bool read_enum_impl(S& str, T& toread, size_t N)
 {
+  constexpr size_t block_size = 64;
+  constexpr uint32_t bound = enum_bound<T>();
   T *ptr = &toread;
-  I holder = 0;
-  for (size_t i = 0; i < N; i++, ptr++)
-  {
-    if (!read(str, holder))
+  I holders[block_size];
+  while (N > 0) {
+    const size_t n = std::min(N, block_size);
+    if (!read(str, holders[0], n))
       return false;
-    *ptr = enum_conversion<T>(holder);
+
+    //no early exit, so that the compiler can vectorize the range check
+    bool in_range = bound > 0;
+    for (size_t i = 0; i < n; i++)
+      in_range &= static_cast<uint64_t>(holders[i]) < bound;
+
+    if (in_range) {
+      for (size_t i = 0; i < n; i++)
+        ptr[i] = static_cast<T>(holders[i]);
+    } else {
+      for (size_t i = 0; i < n; i++)
+        ptr[i] = enum_conversion<T>(holders[i]);
+    }
+
+    ptr += n;
+    N -= n;
   }
   return true;
 }
@@ -685,17 +766,18 @@ bool write(S& str, const T& towrite, size_t N = 1)
     return false;
 
   const T* from = &towrite;
-  if (N > 1 || sizeof(T) > 4) {
-    memcpy(reinterpret_cast<void*>(str.get_cursor()),reinterpret_cast<const void*>(from),sizeof(T)*N);
+  if (N > 1 && sizeof(T) > 1 && str.swap_endianness()) {
+    byte_swap_copy(reinterpret_cast<void*>(str.get_cursor()),reinterpret_cast<const void*>(from),N,sizeof(T));
   } else {
-    T* to = reinterpret_cast<T*>(str.get_cursor());
-    *to = *from;
-  }
-
-  if (sizeof(T) > 1 && str.swap_endianness()) {
-    T* to = reinterpret_cast<T*>(str.get_cursor());
-    for (size_t i = 0; i < N; i++, to++)
-      byte_swap(to);
+    if (N > 1 || sizeof(T) > 4) {
+      memcpy(reinterpret_cast<void*>(str.get_cursor()),reinterpret_cast<const void*>(from),sizeof(T)*N);
+    } else {
+      T* to = reinterpret_cast<T*>(str.get_cursor());
+      *to = *from;
+    }
+
+    if (N == 1 && sizeof(T) > 1 && str.swap_endianness())
+      byte_swap(reinterpret_cast<T*>(str.get_cursor()));
   }
 
   str.incr_position(sizeof(T)*N);
@@ -801,6 +883,74 @@ bool max(S& str, const T& max_sz, size_t N = 1)
  * calls.
  */
 
+/**
+ * @brief
+ * Boolean sequence read function.
+ *
+ * Reads N booleans from str into the first N entries of toread in a single pass,
+ * checking that each of them is encoded as 0 or 1.
+ * Used for sequences of booleans, as these are not contiguous in memory if they are
+ * a std::vector<bool>, and can therefore not be read as a block.
+ *
+ * @param[in, out] str The stream to read from.
+ * @param[out] toread The sequence to read to, needs to hold at least N entries.
+ * @param[in] N The number of booleans to read.
+ *
+ * @return Whether the operation was completed succesfully.
+ */
+template<typename S, typename T, std::enable_if_t<std::is_base_of<cdr_stream, S>::value, bool> = true >
+bool read_bool_sequence(S& str, T& toread, size_t N)
+{
+  if (str.position() == SIZE_MAX
+   || !str.align(1, false)
+   || !str.bytes_available(N))
+    return false;
+
+  auto from = reinterpret_cast<const uint8_t*>(str.get_cursor());
+  uint8_t all_bits = 0;
+  for (size_t i = 0; i < N; i++) {
+    all_bits |= from[i];
+    toread[i] = from[i] != 0;
+  }
+
+  if (all_bits > 1
+   && str.status(serialization_status::illegal_field_value))
+    return false;
+
+  str.incr_position(N);
+
+  return true;
+}
+
+/**
+ * @brief
+ * Boolean sequence write function.
+ *
+ * Writes the first N entries of towrite to str as bytes with the value 0 or 1, in a single pass.
+ *
+ * @param[in, out] str The stream to write to.
+ * @param[in] towrite The sequence to write.
+ * @param[in] N The number of booleans to write.
+ *
+ * @return Whether the operation was completed succesfully.
+ */
+template<typename S, typename T, std::enable_if_t<std::is_base_of<cdr_stream, S>::value, bool> = true >
+bool write_bool_sequence(S& str, const T& towrite, size_t N)
+{
+  if (str.position() == SIZE_MAX
+   || !str.align(1, true)
+   || !str.bytes_available(N))
+    return false;
+
+  auto to = reinterpret_cast<uint8_t*>(str.get_cursor());
+  for (size_t i = 0; i < N; i++)
+    to[i] = towrite[i] ? 1 : 0;
+
+  str.incr_position(N);
+
+  return true;
+}
+
 /**
  * @brief
  * Bounded string read function.
@@ -15,8 +15,9 @@
 #include <cstdint>
 #include <list>
 #include <vector>
-#include <set>
 #include <map>
+#include <utility>
+#include <cassert>
 #include <atomic>
 #include <mutex>
 
@@ -156,7 +157,74 @@ constexpr bit_bound get_bit_bound() { return bit_bound::bb_64_bits; }
 
 typedef struct entity_properties entity_properties_t;
 typedef std::vector<entity_properties_t> propvec;
-typedef std::set<uint32_t> member_id_set;
+
+/**
+ * @brief
+ * Member id set class.
+ *
+ * Keeps track of which members of a struct have been (de)serialized, so that the completeness of the struct
+ * can be checked after reading.
+ * Members are identified by their position among the members of the struct (entity_properties_t::member_index)
+ * instead of by their member id, so the set is a bitset.
+ * The storage of the bits is provided by member_id_set_n, which is sized by the generated streaming functions
+ * to the number of members of the struct, so no heap allocations are necessary.
+ */
+class OMG_DDS_API member_id_set {
+public:
+  member_id_set(const member_id_set &) = delete;
+  member_id_set& operator=(const member_id_set &) = delete;
+
+  /**
+   * @brief
+   * Adds a member to the set.
+   *
+   * @param[in] member_index The position of the member in its struct.
+   */
+  void insert(uint32_t member_index) {
+    assert(member_index < m_n_bits);
+    m_bits[member_index / 64] |= uint64_t(1) << (member_index % 64);
+  }
+
+  /**
+   * @brief
+   * Checks whether a member is in the set.
+   *
+   * @param[in] member_index The position of the member in its struct.
+   *
+   * @return Whether the member was added to the set.
+   */
+  bool contains(uint32_t member_index) const {
+    return member_index < m_n_bits
+        && (m_bits[member_index / 64] & (uint64_t(1) << (member_index % 64)));
+  }
+
+protected:
+  /**
+   * @brief
+   * Constructor.
+   *
+   * @param[in] bits The (zero-initialized) storage for the bits.
+   * @param[in] n_bits The number of bits available in the storage.
+   */
+  member_id_set(uint64_t *bits, size_t n_bits): m_bits(bits), m_n_bits(n_bits) {;}
+
+private:
+  uint64_t *m_bits;
+  size_t m_n_bits;
+};
+
+/**
+ * @brief
+ * Member id set with inline storage for N members.
+ */
+template<size_t N>
+class member_id_set_n: public member_id_set {
+public:
+  member_id_set_n(): member_id_set(m_storage, N), m_storage{} {;}
+
+private:
+  uint64_t m_storage[N / 64 + 1];
+};
 
 /**
  * @brief
@@ -188,6 +256,7 @@ struct OMG_DDS_API entity_properties
   extensibility p_ext = extensibility::ext_final; /**< The extensibility of the entity's parent. */
   uint32_t m_id = 0;                              /**< The member id of the entity, it is the global field by which the entity is identified. */
   uint32_t depth = 0;                             /**< The depth of this entity.*/
+  uint32_t member_index = 0;                      /**< The position of this entity among the members of its parent.*/
   bool must_understand = false;                   /**< If the reading end cannot parse a field with this header, it must discard the entire object.*/
   bool xtypes_necessary = false;                  /**< Is set if any of the members of this entity require xtypes support.*/
   bool implementation_extension = false;          /**< Can be set in XCDR_v1 stream parameter list headers.*/
@@ -207,6 +276,10 @@ struct OMG_DDS_API entity_properties
                        *next_sorted_key     = nullptr,  /**< Pointer to the next entity which is a key member on the same level, going by member id order.*/
                        *prev_sorted_key     = nullptr;  /**< Pointer to the previous entity which is a key member on the same level, going by member id order.*/
 
+  DDSCXX_WARNING_MSVC_OFF(4251)
+  std::vector<std::pair<uint32_t, const entity_properties_t*> > members_by_id;  /**< The members of this entity sorted by member id, only filled for mutable entities.*/
+  DDSCXX_WARNING_MSVC_ON(4251)
+
   /**
    * @brief
    * Print function.
@@ -299,6 +372,21 @@ struct OMG_DDS_API entity_properties
     */
   const entity_properties_t* previous_entity(key_mode key) const;
 
+  /**
+    * @brief
+    * Looks up a member of this entity by its member id.
+    *
+    * Uses the members_by_id index, which is built by the finish function for mutable entities, and is
+    * used when reading parameter lists, where the members can appear in any order.
+    * When the member ids are consecutive from 0, the lookup is a direct index, otherwise it is a binary search.
+    *
+    * @param[in] member_id The member id to look for.
+    * @param[in] key The key mode, if this is not key_mode::not_key, only key members are returned.
+    *
+    * @return Pointer to the member, or nullptr if there is no such member.
+    */
+  const entity_properties_t* find_member(uint32_t member_id, key_mode key) const;
+
 private:
 
   /**
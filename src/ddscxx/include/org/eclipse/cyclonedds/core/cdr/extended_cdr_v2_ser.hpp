@@ -145,6 +145,21 @@ public:
    */
   bool finish_consecutive();
 
+  /**
+   * @brief
+   * Function declaration for starting a member in the straight-line streaming functions of final types.
+   *
+   * Arrays directly inside a member require a d-header, whereas the dimensions of a multi-dimensional
+   * array share one, this marks the member start so the two can be told apart.
+   */
+  void start_member_scope() { m_consecutives.push({false, false}); }
+
+  /**
+   * @brief
+   * Function declaration for finishing a member in the straight-line streaming functions of final types.
+   */
+  void finish_member_scope() { m_consecutives.pop(); }
+
 private:
   typedef struct consecutives {
     consecutives(bool is_array = false, bool d_header_present = false) : is_array(is_array), d_header_present(d_header_present) {}
@@ -27,6 +27,9 @@
 #include <dds/topic/BuiltinTopic.hpp>
 
 #include <org/eclipse/cyclonedds/topic/CDRBlob.hpp>
+#include <org/eclipse/cyclonedds/pub/PublicationQueue.hpp>
+
+#include <memory>
 
 namespace dds { namespace pub {
 template <typename DELEGATE>
@@ -63,8 +66,23 @@ public:
 
     const dds::topic::TopicDescription& topic_description() const;
 
+    /**
+     * @brief Returns the sertype with which the writer serializes its samples.
+     *
+     * This is the sertype ddsc derived from that of the topic for the data representation of
+     * the writer, so samples serialized with it do not need to be converted when written.
+     */
+    const struct ddsi_sertype *get_ser_type() const;
+
     void wait_for_acknowledgments(const dds::core::Duration& timeout);
 
+    /**
+     * @brief Waits until the samples written asynchronously have been handed to ddsc.
+     *
+     * Writers that do not write asynchronously return immediately.
+     */
+    virtual void wait_for_async_writes();
+
     const ::dds::core::status::LivelinessLostStatus liveliness_lost_status();
 
     const ::dds::core::status::OfferedDeadlineMissedStatus offered_deadline_missed_status();
@@ -107,10 +125,33 @@ private:
           const dds::core::Time& timestamp,
           uint32_t statusinfo);
 
+    void
+    write_serdata(dds_entity_t writer,
+          struct ddsi_serdata *data,
+          const dds::core::Time& timestamp,
+          uint32_t statusinfo,
+          const char *error);
+
+    bool
+    write_queued(dds_entity_t writer,
+          const void *data,
+          const dds::core::Time& timestamp,
+          uint32_t statusinfo,
+          const char *error);
+
+    void
+    flush_queued();
+
 protected:
     AnyDataWriterDelegate(const dds::pub::qos::DataWriterQos& qos,
                           const dds::topic::TopicDescription& td);
 
+    void
+    publication_queue(const std::shared_ptr<PublicationQueue>& queue);
+
+    void
+    set_ser_type(dds_entity_t writer);
+
     void
     write_cdr(dds_entity_t writer,
           const org::eclipse::cyclonedds::topic::CDRBlob *data,
@@ -129,6 +170,16 @@ protected:
           const dds::core::InstanceHandle& handle,
           const dds::core::Time& timestamp);
 
+    void
+    write_serdata(dds_entity_t writer,
+          struct ddsi_serdata *data,
+          const dds::core::Time& timestamp);
+
+    void
+    writedispose_serdata(dds_entity_t writer,
+          struct ddsi_serdata *data,
+          const dds::core::Time& timestamp);
+
     bool
     is_loan_supported(const dds_entity_t writer);
 
@@ -146,6 +197,12 @@ protected:
           const dds::core::InstanceHandle& handle,
           const dds::core::Time& timestamp);
 
+    void
+    write_batch(dds_entity_t writer,
+          struct ddsi_serdata * const *batch,
+          size_t n,
+          const dds::core::Time& timestamp);
+
     void
     writedispose(dds_entity_t writer,
                  const void *data,
@@ -189,6 +246,8 @@ protected:
 private:
     dds::pub::qos::DataWriterQos qos_;
     dds::topic::TopicDescription td_;
+    const struct ddsi_sertype *ser_type_;
+    std::shared_ptr<PublicationQueue> queue_;
 
     //@todo static bool copy_data(c_type t, void *data, void *to);
 };
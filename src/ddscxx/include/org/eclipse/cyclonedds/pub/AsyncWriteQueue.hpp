@@ -0,0 +1,569 @@
+// Copyright(c) 2024 ZettaScale Technology and others
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+// v. 1.0 which is available at
+// http://www.eclipse.org/org/documents/edl-v10.php.
+//
+// SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_PUB_ASYNC_WRITE_QUEUE_HPP_
+#define CYCLONEDDS_PUB_ASYNC_WRITE_QUEUE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <dds/core/Time.hpp>
+#include <dds/core/Duration.hpp>
+#include <dds/core/InstanceHandle.hpp>
+#include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
+#include <org/eclipse/cyclonedds/core/MiscUtils.hpp>
+#include <dds/dds.h>
+
+struct ddsi_serdata;
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace pub
+{
+
+/**
+ * @brief
+ * What a write does when the queue of an asynchronous writer is full.
+ */
+enum class AsyncFullPolicy
+{
+  Block,      /**< wait for room, up to the max_blocking_time of the configuration */
+  DropOldest, /**< drop the oldest queued sample to make room */
+  Fail,       /**< refuse the sample by throwing dds::core::OutOfResourcesError */
+};
+
+/**
+ * @brief
+ * Configuration of the asynchronous mode of a writer.
+ */
+struct AsyncWriterConfig
+{
+    size_t queue_size = 1024;                   /**< number of queued samples, rounded up to a power of two */
+    uint32_t threads = 1;                       /**< number of threads serializing and writing the samples */
+    AsyncFullPolicy full_policy = AsyncFullPolicy::Block;   /**< behaviour of a write on a full queue */
+    dds::core::Duration max_blocking_time = dds::core::Duration::infinite();   /**< limit of AsyncFullPolicy::Block */
+};
+
+/**
+ * @brief
+ * Counters of the samples of an asynchronous writer.
+ */
+struct AsyncWriterStatistics
+{
+    uint64_t queued;    /**< samples accepted by write */
+    uint64_t written;   /**< samples handed to ddsc */
+    uint64_t failed;    /**< samples that could not be serialized or written */
+    uint64_t dropped;   /**< samples dropped to make room for newer ones */
+    uint64_t rejected;  /**< samples refused because the queue was full */
+    size_t depth;       /**< samples currently in the queue */
+    size_t max_depth;   /**< largest number of samples that was in the queue */
+};
+
+/**
+ * @brief
+ * Queue of the samples of a writer in asynchronous mode, and the threads that write them.
+ *
+ * Writing a sample moves or copies it into a bounded lock-free queue, the worker threads take the
+ * samples from the queue, serialize them concurrently and hand them to ddsc in the order in which
+ * they were queued. The calling thread only takes a lock to wake up a worker that waits for samples,
+ * to wait for room in a full queue, or to drop a sample from a full queue.
+ *
+ * Errors of the background writes cannot be reported to the writing thread, they are counted in
+ * the statistics instead.
+ */
+template <typename T>
+class AsyncWriteQueue
+{
+public:
+    /** Serializes a sample of an instance, may return nullptr if the sample is to be written as is. */
+    typedef std::function<struct ddsi_serdata *(const T&, const dds::core::InstanceHandle&)> serialize_fn;
+    /** Writes a sample of an instance, or its serialized form which it takes over the reference to. */
+    typedef std::function<void(const T&, struct ddsi_serdata *, const dds::core::InstanceHandle&,
+                               const dds::core::Time&, bool)> submit_fn;
+
+    AsyncWriteQueue(const AsyncWriterConfig& config, serialize_fn serialize, submit_fn submit)
+        : m_mask(queue_capacity(config.queue_size) - 1),
+          m_slots(new slot[m_mask + 1]),
+          m_policy(config.full_policy),
+          m_max_blocking_time(config.max_blocking_time),
+          m_serialize(serialize),
+          m_submit(submit)
+    {
+        for (size_t i = 0; i <= m_mask; i++)
+            m_slots[i].seq.store(i, std::memory_order_relaxed);
+        const uint32_t n = config.threads > 0 ? config.threads : 1;
+        for (uint32_t i = 0; i < n; i++)
+            m_workers.emplace_back(&AsyncWriteQueue::run, this);
+    }
+
+    AsyncWriteQueue(const AsyncWriteQueue&) = delete;
+    AsyncWriteQueue& operator=(const AsyncWriteQueue&) = delete;
+
+    ~AsyncWriteQueue()
+    {
+        shutdown();
+        for (auto &w:m_workers) {
+            if (w.joinable())
+                w.join();
+        }
+    }
+
+    /**
+     * @brief Writes the samples that are still queued and stops the workers.
+     *
+     * Samples pushed after the shutdown are refused. On a worker thread, e.g. from a listener
+     * invoked by one of the writes, the queue is neither drained nor are the workers joined, as
+     * that would wait for the write that is in progress on the thread itself.
+     */
+    void shutdown()
+    {
+        /* Either a concurrent push sees the queue closed, or it is waited for and its sample drained. */
+        m_closed.store(true, std::memory_order_seq_cst);
+        if (current_worker() != this) {
+            std::unique_lock<std::mutex> lock(m_turn_mutex);
+            m_turn_cond.wait(lock, [this]() { return m_pushing.load(std::memory_order_seq_cst) == 0; });
+        }
+        drain();
+        {
+            std::lock_guard<std::mutex> lock(m_pop_mutex);
+            m_stop = true;
+        }
+        m_pop_cond.notify_all();
+        if (current_worker() == this)
+            return;
+        for (auto &w:m_workers) {
+            if (w.joinable())
+                w.join();
+        }
+    }
+
+    /**
+     * @brief Queues a sample.
+     *
+     * @param[in] sample The sample, which is moved into the queue if it is an rvalue.
+     * @param[in] timestamp The source timestamp, the current time is used if it is invalid.
+     * @param[in] dispose Whether the sample also disposes its instance.
+     * @param[in] instance The handle of the instance of the sample, nil if not known.
+     *
+     * @throw dds::core::TimeoutError If the queue stayed full for max_blocking_time.
+     * @throw dds::core::OutOfResourcesError If the queue is full and the policy is to fail.
+     * @throw dds::core::AlreadyClosedError If the queue was shut down.
+     */
+    template <typename S>
+    void push(S&& sample, const dds::core::Time& timestamp, bool dispose,
+              const dds::core::InstanceHandle& instance = dds::core::InstanceHandle(dds::core::null))
+    {
+        /* The source timestamp is that of the write, not that of the background write. */
+        const dds::core::Time ts = timestamp != dds::core::Time::invalid() ? timestamp :
+            org::eclipse::cyclonedds::core::convertTime(dds_time());
+
+        /* Counted while in progress, so that a shutdown waits for it to be queued or refused. */
+        m_pushing.fetch_add(1, std::memory_order_seq_cst);
+        push_guard guard(*this);
+        if (m_closed.load(std::memory_order_seq_cst))
+            ISOCPP_THROW_EXCEPTION(ISOCPP_ALREADY_CLOSED_ERROR, "Asynchronous writer is closed.");
+
+        /* The sample is only moved from by the attempt that succeeds. A sample that could not be
+           copied into its slot is queued as a skipped slot, for which a worker is woken up too. */
+        try {
+            if (!try_push(std::forward<S>(sample), ts, dispose, instance)) {
+                switch (m_policy) {
+                case AsyncFullPolicy::Fail:
+                    m_rejected.fetch_add(1, std::memory_order_relaxed);
+                    ISOCPP_THROW_EXCEPTION(ISOCPP_OUT_OF_RESOURCES_ERROR, "Queue of asynchronous writer is full.");
+                case AsyncFullPolicy::DropOldest:
+                    while (!try_push(std::forward<S>(sample), ts, dispose, instance))
+                        drop_oldest();
+                    break;
+                case AsyncFullPolicy::Block:
+                    wait_and_push(std::forward<S>(sample), ts, dispose, instance);
+                    break;
+                }
+            }
+        } catch (...) {
+            wake_worker();
+            throw;
+        }
+
+        m_queued.fetch_add(1, std::memory_order_relaxed);
+        const size_t d = depth();
+        size_t max = m_max_depth.load(std::memory_order_relaxed);
+        while (d > max && !m_max_depth.compare_exchange_weak(max, d, std::memory_order_relaxed)) { }
+
+        wake_worker();
+    }
+
+    /**
+     * @brief Waits until all samples queued before the call have been written or dropped.
+     *
+     * Waits for the positions in the queue that were taken before the call, which complete in
+     * order, so samples refused in the meantime do not end the wait early. Returns immediately on
+     * a worker thread, which cannot wait for the write it is doing.
+     */
+    void drain()
+    {
+        if (current_worker() == this)
+            return;
+        const size_t target = m_enqueue_pos.load(std::memory_order_seq_cst);
+        std::unique_lock<std::mutex> lock(m_turn_mutex);
+        m_turn_cond.wait(lock, [this, target]() { return m_turn >= target; });
+    }
+
+    /**
+     * @brief Returns the counters of the samples of the writer.
+     */
+    AsyncWriterStatistics statistics() const
+    {
+        AsyncWriterStatistics s;
+        s.queued = m_queued.load(std::memory_order_relaxed);
+        s.written = m_written.load(std::memory_order_relaxed);
+        s.failed = m_failed.load(std::memory_order_relaxed);
+        s.dropped = m_dropped.load(std::memory_order_relaxed);
+        s.rejected = m_rejected.load(std::memory_order_relaxed);
+        s.depth = depth();
+        s.max_depth = m_max_depth.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    struct slot
+    {
+        std::atomic<size_t> seq;
+        T sample;
+        dds::core::InstanceHandle instance;
+        dds::core::Time timestamp;
+        bool dispose;
+        bool skip;      /* set if the sample could not be copied into the slot */
+    };
+
+    /* ends the push of a sample, whether it was queued or refused */
+    struct push_guard
+    {
+        explicit push_guard(AsyncWriteQueue& q) : queue(q) { }
+        ~push_guard()
+        {
+            if (queue.m_pushing.fetch_sub(1, std::memory_order_seq_cst) == 1 &&
+                queue.m_closed.load(std::memory_order_seq_cst)) {
+                std::lock_guard<std::mutex> lock(queue.m_turn_mutex);
+                queue.m_turn_cond.notify_all();
+            }
+        }
+        AsyncWriteQueue& queue;
+    };
+
+    /* the queue of which the current thread is a worker */
+    static const AsyncWriteQueue *&current_worker()
+    {
+        static thread_local const AsyncWriteQueue *queue = nullptr;
+        return queue;
+    }
+
+    static size_t queue_capacity(size_t n)
+    {
+        size_t c = 2;
+        while (c < n)
+            c <<= 1;
+        return c;
+    }
+
+    size_t depth() const
+    {
+        const size_t e = m_enqueue_pos.load(std::memory_order_relaxed);
+        const size_t d = m_dequeue_pos.load(std::memory_order_relaxed);
+        return e > d ? e - d : 0;
+    }
+
+    /* bounded multi-producer multi-consumer queue, the slot sequence numbers tell whether a slot
+       is free for the producer or filled for the consumer at a position */
+    template <typename S>
+    bool try_push(S&& sample, const dds::core::Time& timestamp, bool dispose,
+                  const dds::core::InstanceHandle& instance)
+    {
+        slot *s;
+        size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            s = &m_slots[pos & m_mask];
+            const size_t seq = s->seq.load(std::memory_order_acquire);
+            const intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (dif == 0) {
+                if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        /* The slot is claimed, so it is published also when copying the sample fails, as a
+           slot that the workers skip, for otherwise they would wait for it forever. */
+        try {
+            s->sample = std::forward<S>(sample);
+        } catch (...) {
+            s->skip = true;
+            s->seq.store(pos + 1, std::memory_order_release);
+            throw;
+        }
+        s->instance = instance;
+        s->timestamp = timestamp;
+        s->dispose = dispose;
+        s->skip = false;
+        s->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /* only called with m_pop_mutex held, so that the positions are popped in order, returns
+       skipped slots as well, which are to be counted as failed */
+    bool try_pop(T& sample, dds::core::InstanceHandle& instance, dds::core::Time& timestamp,
+                 bool& dispose, bool& skip, size_t& position)
+    {
+        slot *s;
+        size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            s = &m_slots[pos & m_mask];
+            const size_t seq = s->seq.load(std::memory_order_acquire);
+            const intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (dif == 0) {
+                if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        skip = s->skip;
+        if (!skip) {
+            sample = std::move(s->sample);
+            instance = s->instance;
+            timestamp = s->timestamp;
+            dispose = s->dispose;
+        }
+        s->seq.store(pos + m_mask + 1, std::memory_order_release);
+        position = pos;
+        return true;
+    }
+
+    void wake_worker()
+    {
+        /* Workers that found the queue empty wait for a notification. */
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_idle_workers.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(m_pop_mutex);
+            m_pop_cond.notify_one();
+        }
+    }
+
+    /* only called with m_turn_mutex held, completes a position, and the dropped ones after it */
+    void complete(size_t position)
+    {
+        if (position != m_turn) {
+            m_dropped_positions.push_back(position);
+            return;
+        }
+        m_turn++;
+        while (!m_dropped_positions.empty() && m_dropped_positions.front() == m_turn) {
+            m_dropped_positions.pop_front();
+            m_turn++;
+        }
+    }
+
+    void drop_oldest()
+    {
+        /* If a worker is taking a sample there will be room, otherwise the oldest one is dropped. */
+        std::unique_lock<std::mutex> lock(m_pop_mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            std::this_thread::yield();
+            return;
+        }
+        T sample;
+        dds::core::InstanceHandle instance;
+        dds::core::Time timestamp;
+        bool dispose = false, skip = false;
+        size_t position;
+        if (try_pop(sample, instance, timestamp, dispose, skip, position)) {
+            /* Completed while popping, so that the dropped positions are kept in order. A worker
+               still writing an earlier sample completes the dropped position after its own. */
+            {
+                std::lock_guard<std::mutex> turn_lock(m_turn_mutex);
+                complete(position);
+            }
+            lock.unlock();
+            m_turn_cond.notify_all();
+            if (skip)
+                m_failed.fetch_add(1, std::memory_order_relaxed);
+            else
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename S>
+    void wait_and_push(S&& sample, const dds::core::Time& timestamp, bool dispose,
+                       const dds::core::InstanceHandle& instance)
+    {
+        const dds_duration_t max_blocking_time = org::eclipse::cyclonedds::core::convertDuration(m_max_blocking_time);
+        const bool infinite = max_blocking_time == DDS_INFINITY;
+        const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() +
+            std::chrono::nanoseconds(infinite ? 0 : max_blocking_time);
+
+        /* Workers that take a sample notify the blocked producers. */
+        std::unique_lock<std::mutex> lock(m_room_mutex);
+        m_blocked_producers.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool pushed;
+        try {
+            while (!(pushed = try_push(std::forward<S>(sample), timestamp, dispose, instance))) {
+                if (infinite)
+                    m_room_cond.wait(lock);
+                else if (std::chrono::steady_clock::now() < deadline)
+                    m_room_cond.wait_until(lock, deadline);
+                else
+                    break;
+            }
+        } catch (...) {
+            m_blocked_producers.fetch_sub(1);
+            throw;
+        }
+        m_blocked_producers.fetch_sub(1);
+        if (!pushed) {
+            m_rejected.fetch_add(1, std::memory_order_relaxed);
+            ISOCPP_THROW_EXCEPTION(ISOCPP_TIMEOUT_ERROR, "Queue of asynchronous writer stayed full.");
+        }
+    }
+
+    void run()
+    {
+        T sample;
+        dds::core::InstanceHandle instance;
+        dds::core::Time timestamp;
+        bool dispose = false, skip = false;
+
+        current_worker() = this;
+        for (;;) {
+            size_t ticket;
+            {
+                std::unique_lock<std::mutex> lock(m_pop_mutex);
+                while (!try_pop(sample, instance, timestamp, dispose, skip, ticket)) {
+                    if (m_stop)
+                        return;
+                    /* Announced before checking once more, so that a producer either sees the
+                       worker waiting or the worker sees its sample. */
+                    m_idle_workers.fetch_add(1);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    const bool popped = try_pop(sample, instance, timestamp, dispose, skip, ticket);
+                    if (!popped)
+                        m_pop_cond.wait(lock);
+                    m_idle_workers.fetch_sub(1);
+                    if (popped)
+                        break;
+                }
+            }
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_blocked_producers.load(std::memory_order_relaxed) > 0) {
+                std::lock_guard<std::mutex> lock(m_room_mutex);
+                m_room_cond.notify_all();
+            }
+
+            /* Samples are serialized concurrently, but handed to ddsc in the order of their positions,
+               the ticket of a worker is the position of its sample. */
+            struct ddsi_serdata *sd = nullptr;
+            bool ok = !skip;
+            if (ok) {
+                try {
+                    sd = m_serialize(sample, instance);
+                } catch (...) {
+                    ok = false;
+                }
+            }
+
+            {
+                std::unique_lock<std::mutex> lock(m_turn_mutex);
+                m_turn_cond.wait(lock, [this, ticket]() { return m_turn == ticket; });
+            }
+
+            if (ok) {
+                try {
+                    m_submit(sample, sd, instance, timestamp, dispose);
+                    m_written.fetch_add(1, std::memory_order_relaxed);
+                } catch (...) {
+                    ok = false;
+                }
+            }
+            if (!ok)
+                m_failed.fetch_add(1, std::memory_order_relaxed);
+
+            {
+                std::lock_guard<std::mutex> lock(m_turn_mutex);
+                complete(ticket);
+            }
+            m_turn_cond.notify_all();
+        }
+    }
+
+    const size_t m_mask;
+    std::unique_ptr<slot[]> m_slots;
+    std::atomic<size_t> m_enqueue_pos{0};
+    std::atomic<size_t> m_dequeue_pos{0};
+
+    const AsyncFullPolicy m_policy;
+    const dds::core::Duration m_max_blocking_time;
+    const serialize_fn m_serialize;
+    const submit_fn m_submit;
+
+    std::mutex m_pop_mutex;
+    std::condition_variable m_pop_cond;
+    std::atomic<uint32_t> m_idle_workers{0};
+    bool m_stop = false;
+    std::atomic<bool> m_closed{false};
+
+    std::mutex m_room_mutex;
+    std::condition_variable m_room_cond;
+    std::atomic<uint32_t> m_blocked_producers{0};
+
+    std::mutex m_turn_mutex;
+    std::condition_variable m_turn_cond;
+    size_t m_turn = 0;                          /* all positions before it are written or dropped */
+    std::deque<size_t> m_dropped_positions;     /* dropped positions after m_turn, in order */
+
+    std::atomic<uint32_t> m_pushing{0};
+    std::atomic<uint64_t> m_queued{0};
+    std::atomic<uint64_t> m_written{0};
+    std::atomic<uint64_t> m_failed{0};
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<uint64_t> m_rejected{0};
+    std::atomic<size_t> m_max_depth{0};
+
+    std::vector<std::thread> m_workers;
+};
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_PUB_ASYNC_WRITE_QUEUE_HPP_ */
@@ -0,0 +1,172 @@
+// Copyright(c) 2024 ZettaScale Technology and others
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+// v. 1.0 which is available at
+// http://www.eclipse.org/org/documents/edl-v10.php.
+//
+// SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_PUB_PUBLICATION_QUEUE_HPP_
+#define CYCLONEDDS_PUB_PUBLICATION_QUEUE_HPP_
+
+#include <dds/core/macros.hpp>
+#include <dds/core/Time.hpp>
+#include <dds/core/Duration.hpp>
+#include <dds/dds.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct ddsi_serdata;
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace pub
+{
+
+/**
+ * @brief
+ * Queue of the updates of the writers of a suspended publisher.
+ *
+ * While the publisher is suspended, the writers of the publisher hand the serialized updates to
+ * the queue instead of to ddsc. Resuming the publisher writes all queued updates in the order in
+ * which they were queued, after which each writer that wrote updates is flushed once, so that the
+ * updates of writers that batch their updates are sent in as few messages as possible.
+ *
+ * The queue can also be flushed automatically while it is suspended, once it holds a number of
+ * updates, a number of bytes of serialized data, or its oldest update has been queued for some time.
+ * The updates written by such a flush belong to any of the writers, so an error writing them is not
+ * reported to the write that happened to reach the limit. The first such error is kept instead, and
+ * reported by the next explicit flush or by the resume that ends the suspension.
+ */
+class OMG_DDS_API PublicationQueue
+{
+public:
+    PublicationQueue();
+    ~PublicationQueue();
+
+    PublicationQueue(const PublicationQueue&) = delete;
+    PublicationQueue& operator=(const PublicationQueue&) = delete;
+
+    /**
+     * @brief Suspends the publication of updates, until a matching call to resume.
+     */
+    void suspend();
+
+    /**
+     * @brief Suspends the publication of updates, flushing them automatically.
+     *
+     * The queue is flushed whenever one of the limits is reached, and remains suspended until a
+     * matching call to resume. The limits replace those of an earlier call.
+     *
+     * @param[in] max_samples The number of updates at which to flush, 0 for no limit.
+     * @param[in] max_bytes The size of the serialized updates at which to flush, 0 for no limit.
+     * @param[in] max_delay The time an update may be queued before flushing, infinite for no limit.
+     */
+    void suspend(size_t max_samples, size_t max_bytes, const dds::core::Duration& max_delay);
+
+    /**
+     * @brief Ends a call to suspend, writing the queued updates if it ends the last of them.
+     *
+     * @throw dds::core::PreconditionNotMetError If the queue is not suspended.
+     * @throw dds::core::Exception If writing the queued updates failed, now or in an automatic flush.
+     */
+    void resume();
+
+    /**
+     * @brief Returns whether updates are queued rather than written.
+     */
+    bool suspended() const
+    {
+        return suspended_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Returns whether updates are queued, while suspended or while queued updates are written.
+     */
+    bool queueing() const
+    {
+        return suspended_.load(std::memory_order_seq_cst) || flushing_.load(std::memory_order_seq_cst);
+    }
+
+    /**
+     * @brief Queues an update if the queue is suspended, or behind the updates that are written.
+     *
+     * @param[in] writer The ddsc writer of the update.
+     * @param[in] data The update, of which the queue takes over the reference if it is queued.
+     * @param[in] timestamp The source timestamp of the update, invalid for the current time.
+     *
+     * @return Whether the update was queued, if not, the caller still owns it.
+     */
+    bool enqueue(dds_entity_t writer, struct ddsi_serdata *data, const dds::core::Time& timestamp);
+
+    /**
+     * @brief Writes the queued updates.
+     *
+     * @param[in] report Whether to throw the errors of this flush and of earlier automatic ones,
+     *                   if not, they are kept for the next call that reports them.
+     *
+     * @throw dds::core::Exception If writing the queued updates failed, now or in an automatic flush.
+     */
+    void flush(bool report = true);
+
+    /**
+     * @brief Drops the queued updates, of all writers or of one writer.
+     *
+     * @param[in] writer The writer of which to drop the updates, 0 for all writers.
+     */
+    void discard(dds_entity_t writer = 0);
+
+private:
+    struct update
+    {
+        dds_entity_t writer;
+        struct ddsi_serdata *data;
+    };
+
+    dds_return_t flush_updates(std::unique_lock<std::mutex>& lock, bool resume);
+    void keep_error(dds_return_t ret);
+    void report_error(std::unique_lock<std::mutex>& lock, dds_return_t ret);
+    void flush_on_timeout();
+
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    std::atomic<bool> suspended_;
+    std::atomic<bool> flushing_;      /* set while a thread writes the queued updates */
+    std::thread::id flusher_;         /* the thread that writes the queued updates */
+    uint32_t depth_;
+
+    std::vector<update> updates_;
+    size_t bytes_;
+    std::chrono::steady_clock::time_point oldest_;
+    dds_return_t error_;              /* first error of an automatic flush, not yet reported */
+
+    size_t max_samples_;
+    size_t max_bytes_;
+    dds_duration_t max_delay_;
+
+    std::thread timer_;
+    bool stop_;
+};
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_PUB_PUBLICATION_QUEUE_HPP_ */
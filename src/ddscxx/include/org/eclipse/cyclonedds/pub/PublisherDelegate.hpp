@@ -26,6 +26,9 @@
 #include <org/eclipse/cyclonedds/core/EntityDelegate.hpp>
 #include <org/eclipse/cyclonedds/core/EntitySet.hpp>
 #include <org/eclipse/cyclonedds/pub/AnyDataWriterDelegate.hpp>
+#include <org/eclipse/cyclonedds/pub/PublicationQueue.hpp>
+
+#include <memory>
 
 
 namespace org
@@ -61,7 +64,11 @@ public:
     dds::pub::qos::DataWriterQos default_datawriter_qos() const;
 
     void suspend_publications();
+    void suspend_publications(size_t max_samples,
+                              size_t max_bytes,
+                              const dds::core::Duration& max_delay);
     void resume_publications();
+    const std::shared_ptr<PublicationQueue>& publication_queue() const;
 
     void begin_coherent_changes();
     void end_coherent_changes();
@@ -103,6 +110,7 @@ private:
     dds::pub::qos::DataWriterQos default_dwqos_;
 
     org::eclipse::cyclonedds::core::EntitySet writers;
+    std::shared_ptr<PublicationQueue> queue_;
 };
 
 }
@@ -0,0 +1,184 @@
+// Copyright(c) 2024 ZettaScale Technology and others
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+// v. 1.0 which is available at
+// http://www.eclipse.org/org/documents/edl-v10.php.
+//
+// SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_PUB_SERIALIZED_LOAN_HPP_
+#define CYCLONEDDS_PUB_SERIALIZED_LOAN_HPP_
+
+#include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
+#include <org/eclipse/cyclonedds/core/cdr/cdr_enums.hpp>
+
+#include "dds/ddsi/ddsi_serdata.h"
+
+#include <cstddef>
+
+namespace dds {
+    namespace pub {
+        namespace detail {
+            template <typename T>
+            class DataWriter;
+        }
+    }
+}
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace pub
+{
+
+/**
+ * @brief
+ * A buffer for the serialized payload of a sample, loaned from a writer.
+ *
+ * The loan is obtained from DataWriter::loan_serialized, which allocates the serialized data of
+ * the sample from the serdata pool of the type and writes the encoding header in front of the
+ * payload. The payload is then filled in place, in the encoding given by encoding() and in the
+ * native byte order, after which DataWriter::write takes over the buffer as the serialized data
+ * of the sample, without copying it.
+ *
+ * A loan that is not written returns its buffer to the pool when it is destroyed or reset.
+ */
+class SerializedLoan
+{
+public:
+    typedef org::eclipse::cyclonedds::core::cdr::encoding_version encoding_version;
+
+    SerializedLoan() noexcept
+        : serdata_(nullptr), payload_(nullptr), capacity_(0), size_(0),
+          encoding_(encoding_version::xcdr_v2)
+    {
+    }
+
+    SerializedLoan(SerializedLoan&& other) noexcept
+        : serdata_(other.serdata_), payload_(other.payload_), capacity_(other.capacity_),
+          size_(other.size_), encoding_(other.encoding_)
+    {
+        other.serdata_ = nullptr;
+        other.payload_ = nullptr;
+        other.capacity_ = 0;
+        other.size_ = 0;
+    }
+
+    SerializedLoan& operator=(SerializedLoan&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            serdata_ = other.serdata_;
+            payload_ = other.payload_;
+            capacity_ = other.capacity_;
+            size_ = other.size_;
+            encoding_ = other.encoding_;
+            other.serdata_ = nullptr;
+            other.payload_ = nullptr;
+            other.capacity_ = 0;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    SerializedLoan(const SerializedLoan&) = delete;
+    SerializedLoan& operator=(const SerializedLoan&) = delete;
+
+    ~SerializedLoan()
+    {
+        reset();
+    }
+
+    /**
+     * @brief Returns the start of the payload, behind the encoding header.
+     */
+    unsigned char* data() noexcept { return payload_; }
+    const unsigned char* data() const noexcept { return payload_; }
+
+    /**
+     * @brief Returns the size of the payload that is written.
+     */
+    size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief Returns the size of the payload with which the loan was created.
+     */
+    size_t capacity() const noexcept { return capacity_; }
+
+    /**
+     * @brief Sets the size of the payload that is written, for payloads that turned out smaller.
+     *
+     * @throw dds::core::InvalidArgumentError If the size exceeds the capacity of the loan.
+     */
+    void resize(size_t size)
+    {
+        if (size > capacity_)
+            ISOCPP_THROW_EXCEPTION(ISOCPP_INVALID_ARGUMENT_ERROR, "Size exceeds the capacity of the loan.");
+        size_ = size;
+    }
+
+    /**
+     * @brief Returns the encoding in which the payload is to be serialized.
+     */
+    encoding_version encoding() const noexcept { return encoding_; }
+
+    /**
+     * @brief Returns whether the loan holds a buffer.
+     */
+    explicit operator bool() const noexcept { return serdata_ != nullptr; }
+
+    /**
+     * @brief Returns the buffer to the pool without writing it.
+     */
+    void reset() noexcept
+    {
+        if (serdata_ != nullptr)
+            ddsi_serdata_unref(serdata_);
+        serdata_ = nullptr;
+        payload_ = nullptr;
+        capacity_ = 0;
+        size_ = 0;
+    }
+
+private:
+    template <typename T>
+    friend class dds::pub::detail::DataWriter;
+
+    SerializedLoan(struct ddsi_serdata *serdata, unsigned char *payload, size_t size, encoding_version encoding) noexcept
+        : serdata_(serdata), payload_(payload), capacity_(size), size_(size), encoding_(encoding)
+    {
+    }
+
+    /* hands the serdata over to the writer, which takes over the reference */
+    struct ddsi_serdata *release() noexcept
+    {
+        struct ddsi_serdata *serdata = serdata_;
+        serdata_ = nullptr;
+        payload_ = nullptr;
+        capacity_ = 0;
+        size_ = 0;
+        return serdata;
+    }
+
+    struct ddsi_serdata *serdata_;
+    unsigned char *payload_;
+    size_t capacity_;
+    size_t size_;
+    encoding_version encoding_;
+};
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_PUB_SERIALIZED_LOAN_HPP_ */
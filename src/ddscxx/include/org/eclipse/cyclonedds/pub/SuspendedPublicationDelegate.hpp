@@ -28,8 +28,7 @@ namespace pub
 {
 
 
-//class OMG_DDS_API SuspendedPublicationDelegate
-class SuspendedPublicationDelegate
+class OMG_DDS_API SuspendedPublicationDelegate
 {
 public:
     SuspendedPublicationDelegate(const dds::pub::Publisher& pub);
@@ -68,6 +68,9 @@ public:
     virtual uint32_t get_length() const = 0;
     virtual SamplesHolder& operator++(int) = 0;
     virtual void append_sample(void *sample, const dds_sample_info_t *si) = 0;
+    /* appends a sample that is being taken, holders copying the samples can move them instead if
+       nothing else refers to them */
+    virtual void take_sample(void *sample, const dds_sample_info_t *si) { append_sample(sample, si); }
     static dds::sub::SampleInfo sample_info_from_c(const dds_sample_info_t *si);
 };
 
@@ -271,6 +274,12 @@ private:
         const struct ddsi_sertype *,
         struct ddsi_serdata *sd);
 
+    static dds_return_t take_collector_callback_fn (
+        void *arg,
+        const dds_sample_info_t *si,
+        const struct ddsi_sertype *,
+        struct ddsi_serdata *sd);
+
 protected:
     org::eclipse::cyclonedds::core::ObjectSet queries;
     dds::sub::qos::DataReaderQos qos_;
@@ -136,6 +136,67 @@ public:
         return true;
     }
 
+    /**
+     * @brief Returns whether instances of TOPIC can be reused to deserialize other samples into.
+     *
+     * Used by the sample pool of the reader side, which keeps the memory of strings and vectors of
+     * previously received samples.
+     * This trait will be generated as true if all types in TOPIC's member tree are final and have no
+     * optional or external members, as then every member is overwritten by a deserialization.
+     *
+     * @return Whether instances of TOPIC can be recycled.
+     */
+    static constexpr bool isRecyclable()
+    {
+        return false;
+    }
+
+    /**
+     * @brief Returns the maximum size of the key of TOPIC, as it is serialized for the keyhash.
+     *
+     * Used to determine whether the keyhash of TOPIC contains the key itself or its md5 hash, and
+     * therefore whether a sample can be reconstructed from a keyhash.
+     * This trait will be generated if idlcxx can determine the size of the key, which is not the
+     * case for e.g. unbounded keys, keys using the keylist pragma or keys in derived types.
+     *
+     * @return The maximum size of the serialized key, SIZE_MAX if it is not known at compile time.
+     */
+    static constexpr size_t keyMaxSize()
+    {
+        return SIZE_MAX;
+    }
+
+    /**
+     * @brief Returns whether the key of TOPIC can be read from a serialized sample as if it were a serialized key.
+     *
+     * Used on the reader side to determine the key of a received sample without deserializing all of it,
+     * the sample itself is then only deserialized when it is accessed.
+     * This trait will be generated as true if the key members of TOPIC precede all other members, or if
+     * TOPIC is mutable, and the types of the key members are made up of key members only.
+     *
+     * @return Whether the key can be read from the serialized sample.
+     */
+    static constexpr bool isKeyReadableFromData()
+    {
+        return false;
+    }
+
+    /**
+     * @brief Returns the size of the serialized data that is stored in the serdata itself.
+     *
+     * The serialized data of samples of TOPIC that fit are stored in the same allocation as the
+     * serdata, larger ones in a separate buffer. This trait can be specialized to tune the size
+     * for a type, a size of 0 always uses a separate buffer. As every serdata of TOPIC has this
+     * storage, including those kept in reader histories and writer caches, this is the memory
+     * each of them uses in addition to that of the serdata itself.
+     *
+     * @return The size in bytes.
+     */
+    static constexpr size_t inlineDataSize()
+    {
+        return 128;
+    }
+
     /**
      * @brief Returns the allowable encodings for this topic.
      *
@@ -171,19 +232,12 @@ public:
      *
      * @param[in] kind The kind of typeid.
      *
-     * @return A pointer to the typeid of this topic.
+     * @return A pointer to a copy of the typeid of this topic, owned by the caller.
      */
     static ddsi_typeid_t* getTypeId(const struct ddsi_sertype *, ddsi_typeid_kind_t kind)
     {
-        auto ti = getTypeInfo(NULL);
-        if (ti) {
-            auto id = ddsi_typeinfo_typeid(ti, kind);
-            ddsi_typeinfo_fini(ti);
-            ddsrt_free(ti);
-            return id;
-        } else {
-            return nullptr;
-        }
+        auto ti = decodedTypeInfo();
+        return ti ? ddsi_typeinfo_typeid(ti, kind) : nullptr;
     }
 
     /**
@@ -202,14 +256,31 @@ public:
     /**
      * @brief Returns the type info for TOPIC.
      *
-     * Takes the type info blob for this topic which is part of the generated type traits, and deserializes
-     * the type info from this blob.
+     * Copies the type info which is decoded from the type info blob of this topic, which is part of the
+     * generated type traits, the first time it is needed.
      *
-     * @return A pointer to the typeinfo for this topic.
+     * @return A pointer to a copy of the typeinfo for this topic, owned by the caller.
      */
     static ddsi_typeinfo_t* getTypeInfo(const struct ddsi_sertype *)
     {
-        return ddsi_typeinfo_deser(const_cast<unsigned char*>(type_info_blob()), type_info_blob_sz());
+        auto ti = decodedTypeInfo();
+        return ti ? ddsi_typeinfo_dup(ti) : nullptr;
+    }
+
+    /**
+     * @brief Returns the type info decoded from the type info blob of TOPIC.
+     *
+     * The blob is decoded once, on first use, as the type info is needed for each topic, reader and
+     * writer of TOPIC and during the matching of remote endpoints. The result is shared and is never
+     * freed, as sertypes of TOPIC may ask for it at any time.
+     *
+     * @return A pointer to the shared typeinfo for this topic, or nullptr if the blob cannot be decoded.
+     */
+    static const ddsi_typeinfo_t* decodedTypeInfo()
+    {
+        static const ddsi_typeinfo_t* ti =
+            ddsi_typeinfo_deser(const_cast<unsigned char*>(type_info_blob()), type_info_blob_sz());
+        return ti;
     }
 
     /**
@@ -12,7 +12,9 @@
 #define DDSCXXDATATOPIC_HPP_
 
 #include <algorithm>
+#include <cstddef>
 #include <memory>
+#include <new>
 #include <string>
 #include <cstring>
 #include <vector>
@@ -28,6 +30,8 @@
 #include "org/eclipse/cyclonedds/core/cdr/fragchain.hpp"
 #include "org/eclipse/cyclonedds/topic/TopicTraits.hpp"
 #include "org/eclipse/cyclonedds/topic/hash.hpp"
+#include "org/eclipse/cyclonedds/topic/sample_pool.hpp"
+#include "org/eclipse/cyclonedds/topic/serdata_pool.hpp"
 
 constexpr size_t DDSI_RTPS_HEADER_SIZE = 4u;
 
@@ -82,6 +86,28 @@ using org::eclipse::cyclonedds::topic::TopicTraits;
 template<typename T, class S, key_mode K>
 bool get_serialized_size(const T& sample, size_t &sz);
 
+template<typename T>
+size_t max_key_size(const T& sample)
+{
+  basic_cdr_stream str(endianness::big_endian);
+  if (!max(str, sample, key_mode::sorted)) {
+    assert(false);
+    return SIZE_MAX;
+  }
+  return str.position();
+}
+
+/* the maximum size of the key of T, which is only calculated if idlcxx could not determine it */
+template<typename T>
+size_t key_size_max()
+{
+  if (TopicTraits<T>::keyMaxSize() != SIZE_MAX)
+    return TopicTraits<T>::keyMaxSize();
+
+  static const size_t max_sz = max_key_size(T());
+  return max_sz;
+}
+
 template<typename T>
 bool to_key(const T& tokey, ddsi_keyhash_t& hash)
 {
@@ -91,42 +117,46 @@ bool to_key(const T& tokey, ddsi_keyhash_t& hash)
     return true;
   } else
   {
+    //whether the key needs to be md5 hashed depends only on the type
+    const size_t max_sz = key_size_max<T>();
+
     basic_cdr_stream str(endianness::big_endian);
-    size_t sz = 0;
-    if (!get_serialized_size<T, basic_cdr_stream, key_mode::sorted>(tokey, sz)) {
+    if (max_sz <= sizeof(hash.value))
+    {
+      //the key always fits in the keyhash, so it is written directly into it, padded with zeroes
+      memset(&(hash.value), 0x0, sizeof(hash.value));
+      str.set_buffer(hash.value, sizeof(hash.value));
+      if (!write(str, tokey, key_mode::sorted)) {
+        assert(false);
+        return false;
+      }
+      return false;
+    }
+
+    size_t sz = max_sz;
+    if (sz == SIZE_MAX &&
+        !get_serialized_size<T, basic_cdr_stream, key_mode::sorted>(tokey, sz)) {
       assert(false);
       return false;
     }
-    size_t padding = 0;
-    if (sz < 16)
-      padding = (16 - sz % 16)%16;
-    std::vector<unsigned char> buffer(sz + padding);
-    if (padding)
-      memset(buffer.data() + sz, 0x0, padding);
+
+    //scratch buffer for the serialized key, which only grows to the largest key serialized on this thread
+    static thread_local std::vector<unsigned char> buffer;
+    if (buffer.size() < std::max(sz, sizeof(hash.value)))
+      buffer.resize(std::max(sz, sizeof(hash.value)));
     str.set_buffer(buffer.data(), sz);
     if (!write(str, tokey, key_mode::sorted)) {
       assert(false);
       return false;
     }
-    static thread_local bool (*fptr)(const std::vector<unsigned char>&, ddsi_keyhash_t&) = NULL;
-    if (fptr == NULL)
-    {
-      if (!max(str, tokey, key_mode::sorted)) {
-        assert(false);
-        return false;
-      }
-      if (str.position() <= 16)
-      {
-        //bind to unmodified function which just copies buffer into the keyhash
-        fptr = &org::eclipse::cyclonedds::topic::simple_key;
-      }
-      else
-      {
-        //bind to MD5 hash function
-        fptr = &org::eclipse::cyclonedds::topic::complex_key;
-      }
+
+    //keys shorter than the keyhash are zero padded before hashing
+    size_t hashed_sz = str.position();
+    if (hashed_sz < sizeof(hash.value)) {
+      memset(buffer.data() + hashed_sz, 0x0, sizeof(hash.value) - hashed_sz);
+      hashed_sz = sizeof(hash.value);
     }
-    return (*fptr)(buffer, hash);
+    return org::eclipse::cyclonedds::topic::complex_key(buffer.data(), hashed_sz, hash);
   }
 }
 
@@ -308,27 +338,34 @@ bool serialize_into_impl(void *hdr,
                          void *buffer,
                          size_t buf_sz,
                          const T &sample,
-                         key_mode mode)
+                         key_mode mode,
+                         size_t *bytes_written = nullptr)
 {
   CHECK_FOR_NULL(buffer);
   CHECK_FOR_NULL(hdr);
 
   S str;
   str.set_buffer(buffer, buf_sz);
-  return (write_header<T,S>(hdr)
-        && write(str, sample, mode)
-        && finish_header<T>(hdr, buf_sz));
+  if (!write_header<T,S>(hdr)
+   || !write(str, sample, mode)
+   || !finish_header<T>(hdr, str.position()))
+    return false;
+
+  if (bytes_written)
+    *bytes_written = str.position();
+  return true;
 }
 
 template<typename T, class S>
 bool serialize_into(void *buffer,
                     size_t buf_sz,
                     const T &sample,
-                    key_mode mode)
+                    key_mode mode,
+                    size_t *bytes_written = nullptr)
 {
   assert(buf_sz >= DDSI_RTPS_HEADER_SIZE);
   void *cdr_start = calc_offset(buffer, DDSI_RTPS_HEADER_SIZE);
-  return serialize_into_impl<T,S>(buffer,cdr_start,buf_sz, sample, mode);
+  return serialize_into_impl<T,S>(buffer, cdr_start, buf_sz - DDSI_RTPS_HEADER_SIZE, sample, mode, bytes_written);
 }
 
 template <typename T, typename S>
@@ -393,6 +430,40 @@ uint32_t serdata_size(const ddsi_serdata* dcmn)
   return static_cast<uint32_t>(static_cast<const ddscxx_serdata<T>*>(dcmn)->size());
 }
 
+/* gets a sample holding at least the key of d, without deserializing into d: this is d's own
+   sample if it has one, otherwise only the key members are read into a per-thread scratch sample,
+   if the key can be read from the serialized data directly, or else the whole sample is */
+template <typename T>
+const T* serdata_key_sample(const ddscxx_serdata<T>* d)
+{
+  const T* t = d->peekT();
+  if (t != nullptr)
+    return t;
+
+  static thread_local T key_sample;
+  if (TopicTraits<T>::isKeyless())
+    return &key_sample;
+
+  const ddsi_serdata_kind kind = (d->kind == SDK_DATA && !TopicTraits<T>::isKeyReadableFromData()) ? SDK_DATA : SDK_KEY;
+  if (!deserialize_sample_from_buffer(d->data(), d->size(), key_sample, kind))
+    return nullptr;
+  return &key_sample;
+}
+
+/* sets the key of received data, received data is deserialized here, so that malformed samples
+   are rejected on receipt instead of when they are accessed */
+template <typename T>
+bool serdata_key_from_ser(ddscxx_serdata<T>* d)
+{
+  const T* t = d->getT();
+  if (t == nullptr)
+    return false;
+
+  d->key_md5_hashed() = to_key(*t, d->key());
+  d->populate_hash();
+  return true;
+}
+
 template <typename T>
 ddsi_serdata *serdata_from_ser(
   const ddsi_sertype* type,
@@ -400,17 +471,16 @@ ddsi_serdata *serdata_from_ser(
   const struct ddsi_rdata* fragchain,
   size_t size)
 {
-  auto d = new ddscxx_serdata<T>(type, kind);
+  /* received data is deserialized into a sample of the serdata itself, unless that comes from the sample pool */
+  auto d = ddscxx_serdata<T>::create(type, kind, kind == SDK_DATA && !org::eclipse::cyclonedds::topic::sample_pool<T>::instance().enabled());
+
+  /* the received bytes are kept as they are, so that forwarding and read_cdr see exactly what
+     was received, as the receive buffers cannot be referenced once this returns they are copied */
   d->resize(size);
   auto cursor = static_cast<unsigned char*>(d->data());
   org::eclipse::cyclone::core::cdr::serdata_from_ser_copyin_fragchain (cursor, fragchain, size);
 
-  if (d->getT())
-  {
-    d->key_md5_hashed() = to_key(*d->getT(), d->key());
-    d->populate_hash();
-  }
-  else
+  if (!serdata_key_from_ser(d))
   {
     delete d;
     d = nullptr;
@@ -427,7 +497,8 @@ ddsi_serdata *serdata_from_ser_iov(
   const ddsrt_iovec_t* iov,
   size_t size)
 {
-  auto d = new ddscxx_serdata<T>(type, kind);
+  /* received data is deserialized into a sample of the serdata itself, unless that comes from the sample pool */
+  auto d = ddscxx_serdata<T>::create(type, kind, kind == SDK_DATA && !org::eclipse::cyclonedds::topic::sample_pool<T>::instance().enabled());
   d->resize(size);
 
   size_t off = 0;
@@ -441,11 +512,7 @@ ddsi_serdata *serdata_from_ser_iov(
     off += n_bytes;
   }
 
-  T* ptr = d->getT();
-  if (ptr) {
-    d->key_md5_hashed() = to_key(*ptr, d->key());
-    d->populate_hash();
-  } else {
+  if (!serdata_key_from_ser(d)) {
     delete d;
     d = nullptr;
   }
@@ -454,40 +521,63 @@ ddsi_serdata *serdata_from_ser_iov(
 
 }
 
-template <typename T>
-ddsi_serdata *serdata_from_keyhash(
-  const ddsi_sertype* type,
-  const struct ddsi_keyhash* keyhash)
-{
-  (void)keyhash;
-  (void)type;
-  //replace with (if key_size_max <= 16) then populate the data class with the key hash
-  return nullptr;
-}
+template <typename T, class S> class ddscxx_sertype;
 
+/* creates the serdata of a sample, taking its key from key if that is set, e.g. because the key of
+   the instance of the sample is already known, instead of deriving it from the sample */
 template <typename T, class S>
-ddsi_serdata *serdata_from_sample(
+ddsi_serdata *serdata_from_sample_impl(
   const ddsi_sertype* typecmn,
   enum ddsi_serdata_kind kind,
-  const void* sample)
+  const T& msg,
+  const ddsi_keyhash_t *key,
+  bool key_md5_hashed)
 {
   assert(kind != SDK_EMPTY);
-  auto d = new ddscxx_serdata<T>(typecmn, kind);
-  const auto& msg = *static_cast<const T*>(sample);
+  auto d = ddscxx_serdata<T>::create(typecmn, kind, kind == SDK_DATA);
   size_t sz = 0;
   const bool k = (kind == SDK_KEY);
+  const key_mode mode = k ? key_mode::unsorted : key_mode::not_key;
+  auto st = static_cast<const ddscxx_sertype<T,S>*>(typecmn);
+  size_t hint = (!k && !TopicTraits<T>::isSelfContained()) ? st->size_hint() : 0;
+
+  /* the size of types which are not selfcontained differs per sample, so they are first serialized in
+     a single pass into a buffer sized by the sertype's size hint, and only if that does not fit are they
+     serialized again after calculating the exact size */
+  if (hint) {
+    d->resize(hint + DDSI_RTPS_HEADER_SIZE);
+    if (serialize_into<T,S>(d->data(), d->size(), msg, mode, &sz)) {
+      d->shrink(sz + DDSI_RTPS_HEADER_SIZE);
+      st->update_size_hint(sz);
+      goto success;
+    }
+  }
 
   if ((k && !get_serialized_size<T,S,key_mode::unsorted>(msg, sz)) ||
       (!k && !get_serialized_size<T,S,key_mode::not_key>(msg, sz)))
     goto failure;
 
+  if (!k && !TopicTraits<T>::isSelfContained())
+    st->update_size_hint(sz);
+
   sz += DDSI_RTPS_HEADER_SIZE;
   d->resize(sz);
 
-  if (!serialize_into<T,S>(d->data(), sz, msg, k ? key_mode::unsorted : key_mode::not_key))
+  if (!serialize_into<T,S>(d->data(), sz, msg, mode))
     goto failure;
 
-  d->key_md5_hashed() = to_key(msg, d->key());
+success:
+  if (key) {
+#ifndef NDEBUG
+    ddsi_keyhash_t check;
+    (void) to_key(msg, check);
+    assert(memcmp(check.value, key->value, sizeof(check.value)) == 0);
+#endif
+    d->key() = *key;
+    d->key_md5_hashed() = key_md5_hashed;
+  } else {
+    d->key_md5_hashed() = to_key(msg, d->key());
+  }
   d->setT(&msg);
   d->populate_hash();
   return d;
@@ -498,6 +588,36 @@ failure:
   return nullptr;
 }
 
+template <typename T, class S>
+ddsi_serdata *serdata_from_sample(
+  const ddsi_sertype* typecmn,
+  enum ddsi_serdata_kind kind,
+  const void* sample)
+{
+  return serdata_from_sample_impl<T,S>(typecmn, kind, *static_cast<const T*>(sample), nullptr, false);
+}
+
+template <typename T, class S>
+ddsi_serdata *serdata_from_keyhash(
+  const ddsi_sertype* type,
+  const struct ddsi_keyhash* keyhash)
+{
+  //the keyhash only contains the key itself if the key always fits, otherwise it is its md5 hash
+  T sample;
+  if (!TopicTraits<T>::isKeyless())
+  {
+    if (key_size_max<T>() > sizeof(keyhash->value))
+      return nullptr;
+
+    basic_cdr_stream str(endianness::big_endian);
+    str.set_buffer(const_cast<unsigned char*>(keyhash->value), sizeof(keyhash->value));
+    if (!read(str, sample, key_mode::sorted))
+      return nullptr;
+  }
+
+  return serdata_from_sample<T, S>(type, SDK_KEY, &sample);
+}
+
 template <typename T>
 void serdata_to_ser(const ddsi_serdata* dcmn, size_t off, size_t sz, void* buf)
 {
@@ -559,7 +679,7 @@ ddsi_serdata *serdata_to_untyped(const ddsi_serdata* dcmn)
   if (d->loan && (d->loan->metadata->sample_state == DDS_LOANED_SAMPLE_STATE_RAW_KEY || d->loan->metadata->sample_state == DDS_LOANED_SAMPLE_STATE_RAW_DATA))
     t = static_cast<const T*>(d->loan->sample_ptr);
   else
-    t = d->getT();
+    t = serdata_key_sample(d);
   size_t sz = 0;
   if (t == nullptr || !get_serialized_size<T,S,key_mode::unsorted>(*t, sz))
     goto failure;
@@ -679,7 +799,7 @@ struct ddsi_serdata* serdata_from_loaned_sample (
       memcpy (d->loan->sample_ptr, sample, d->loan->metadata->sample_size);
     }
     d->key_md5_hashed() = to_key(*sample_in, d->key());
-    d->populate_hash(*sample_in);
+    d->populate_hash();
   }
   else
   {
@@ -763,7 +883,7 @@ struct ddscxx_serdata_ops: public ddsi_serdata_ops {
   &serdata_size<T>,
   &serdata_from_ser<T>,
   &serdata_from_ser_iov<T>,
-  &serdata_from_keyhash<T>,
+  &serdata_from_keyhash<T, S>,
   &serdata_from_sample<T, S>,
   &serdata_to_ser<T>,
   &serdata_to_ser_ref<T>,
@@ -779,33 +899,87 @@ struct ddscxx_serdata_ops: public ddsi_serdata_ops {
   } { ; }
 };
 
+/* storage for the serialized data of small samples, which is part of the serdata itself */
+template <size_t N>
+struct serdata_inline_data
+{
+  alignas(8) unsigned char bytes[N];
+  unsigned char *get() { return bytes; }
+};
+
+template <>
+struct serdata_inline_data<0>
+{
+  unsigned char *get() { return nullptr; }
+};
+
+/* storage for the sample directly behind the serdata, which only the serdata that get a sample of
+   their own are created with (see ddscxx_serdata::create), and only if T is not too large to make
+   that worthwhile and does not need more alignment than the serdata has; it can only be claimed
+   once, as the sample of a serdata is never replaced */
+template <typename T, bool INLINE = (sizeof(T) <= 1024 && alignof(T) <= alignof(std::max_align_t))>
+struct serdata_inline_sample
+{
+  /* the number of bytes needed behind an object of sz bytes */
+  static constexpr size_t extra_size(size_t sz) { return (alignof(T) - sz % alignof(T)) % alignof(T) + sizeof(T); }
+  unsigned char *bytes = nullptr;
+  std::atomic<bool> claimed{ false };
+  void* claim() { return bytes && !claimed.exchange(true, std::memory_order_acq_rel) ? bytes : nullptr; }
+  bool contains(const T* t) const { return bytes && static_cast<const void*>(t) == bytes; }
+};
+
+template <typename T>
+struct serdata_inline_sample<T, false>
+{
+  static constexpr size_t extra_size(size_t) { return 0; }
+  unsigned char *bytes = nullptr;
+  void* claim() { return nullptr; }
+  bool contains(const T*) const { return false; }
+};
+
 template <typename T>
 class ddscxx_serdata : public ddsi_serdata {
   size_t m_size{ 0 };
-  std::unique_ptr<unsigned char[]> m_data{ nullptr };
+  size_t m_capacity{ 0 };
+  unsigned char *m_data{ nullptr };
   ddsi_keyhash_t m_key;
   bool m_key_md5_hashed = false;
   std::atomic<T *> m_t;  //use a recursive mutex and do all modifications inside it?
+  bool m_t_recycled = false;  //m_t was taken from the sample pool
+  static constexpr size_t inline_data_size = org::eclipse::cyclonedds::topic::TopicTraits<T>::inlineDataSize();
+  serdata_inline_data<inline_data_size> m_inline_data;
+  serdata_inline_sample<T> m_inline_sample;
 
 public:
   bool hash_populated = false;
   ddscxx_serdata(const ddsi_sertype* type, ddsi_serdata_kind kind);
+  static ddscxx_serdata* create(const ddsi_sertype* type, ddsi_serdata_kind kind, bool with_sample);
   ~ddscxx_serdata();
+  ddscxx_serdata(const ddscxx_serdata&) = delete;
+  ddscxx_serdata& operator=(const ddscxx_serdata&) = delete;
+  static void* operator new(size_t sz);
+  static void operator delete(void* ptr);
   void resize(size_t requested_size);
+  void shrink(size_t requested_size);
   size_t size() const { return m_size; }
-  void* data() const { return m_data.get(); }
+  void* data() const { return m_data; }
   ddsi_keyhash_t& key() { return m_key; }
   const ddsi_keyhash_t& key() const { return m_key; }
   bool& key_md5_hashed() { return m_key_md5_hashed; }
   const bool& key_md5_hashed() const { return m_key_md5_hashed; }
-  void populate_hash(const T & sample);
   void populate_hash();
   T* setT(const T* toset);
   T* getT(bool force_deserialization = true);
+  const T* peekT() const { return m_t.load(std::memory_order_acquire); }
+  bool extractT(T& to, bool take);
   void setLoan(dds_loaned_sample_t *newloan);
 
 private:
   void deserialize_and_update_sample(uint8_t * buffer, size_t sz, T *& t, bool force_deserialization);
+  static org::eclipse::cyclonedds::topic::serdata_pool<T> &pool() { return org::eclipse::cyclonedds::topic::serdata_pool<T>::instance(); }
+  void release_data();
+  T* acquire_sample(bool& recycle);
+  void release_sample(T* t, bool recycled);
 };
 
 template <typename T>
@@ -816,14 +990,43 @@ ddscxx_serdata<T>::ddscxx_serdata(const ddsi_sertype* type, ddsi_serdata_kind ki
   ddsi_serdata_init(this, type, kind);
 }
 
+/* creates a serdata, with room for its sample directly behind it if with_sample is set, for the
+   serdata that get a sample of their own: the room is only worth its memory for serdata that hold
+   the data of a sample, and whose sample is not taken from the sample pool */
+template <typename T>
+ddscxx_serdata<T>* ddscxx_serdata<T>::create(const ddsi_sertype* type, ddsi_serdata_kind kind, bool with_sample)
+{
+  const size_t extra = serdata_inline_sample<T>::extra_size(sizeof(ddscxx_serdata));
+  if (!with_sample || extra == 0)
+    return new ddscxx_serdata(type, kind);
+
+  void* p = pool().allocate(sizeof(ddscxx_serdata) + extra);
+  auto d = ::new (p) ddscxx_serdata(type, kind);
+  d->m_inline_sample.bytes = static_cast<unsigned char*>(p) + sizeof(ddscxx_serdata) + extra - sizeof(T);
+  return d;
+}
+
 template <typename T>
 ddscxx_serdata<T>::~ddscxx_serdata()
 {
   T* t = m_t.load(std::memory_order_acquire);
   if (!loan || loan->sample_ptr != t)
-    delete t;
+    release_sample(t, m_t_recycled);
   if (loan)
     dds_loaned_sample_unref (loan);
+  release_data();
+}
+
+template <typename T>
+void* ddscxx_serdata<T>::operator new(size_t sz)
+{
+  return pool().allocate(sz);
+}
+
+template <typename T>
+void ddscxx_serdata<T>::operator delete(void* ptr)
+{
+  pool().deallocate(ptr);
 }
 
 template <typename T>
@@ -831,43 +1034,62 @@ void ddscxx_serdata<T>::resize(size_t requested_size)
 {
   if (!requested_size) {
     m_size = 0;
-    m_data.reset();
+    release_data();
     return;
   }
 
   /* FIXME: CDR padding in DDSI makes me do this to avoid reading beyond the bounds
   when copying data to network.  Should fix Cyclone to handle that more elegantly.  */
   size_t n_pad_bytes = (0 - requested_size) % 4;
-  m_data.reset(new unsigned char[requested_size + n_pad_bytes]);
   m_size = requested_size + n_pad_bytes;
+  if (m_size > m_capacity) {
+    release_data();
+    if (m_size <= inline_data_size) {
+      m_data = m_inline_data.get();
+      m_capacity = inline_data_size;
+    } else {
+      m_data = static_cast<unsigned char*>(pool().allocate(m_size, &m_capacity));
+    }
+  }
 
   // zero the very end. The caller isn't necessarily going to overwrite it.
-  std::memset(calc_offset(m_data.get(), static_cast<ptrdiff_t>(requested_size)), '\0', n_pad_bytes);
+  std::memset(calc_offset(m_data, static_cast<ptrdiff_t>(requested_size)), '\0', n_pad_bytes);
 }
 
 template <typename T>
-void ddscxx_serdata<T>::populate_hash(const T & sample)
+void ddscxx_serdata<T>::release_data()
 {
-  if (hash_populated)
-    return;
+  if (m_data != m_inline_data.get())
+    pool().deallocate(m_data);
+  m_data = nullptr;
+  m_capacity = 0;
+}
 
-  key_md5_hashed() = to_key(sample, key());
-  if (!key_md5_hashed())
-  {
-    ddsi_keyhash_t buf;
-    ddsrt_md5_state_t md5st;
-    ddsrt_md5_init(&md5st);
-    ddsrt_md5_append(&md5st, static_cast<const ddsrt_md5_byte_t*>(key().value), 16);
-    ddsrt_md5_finish(&md5st, static_cast<ddsrt_md5_byte_t*>(buf.value));
-    memcpy(&(hash), buf.value, 4);
-  }
-  else
-  {
-    memcpy(&(hash), key().value, 4);
+template <typename T>
+void ddscxx_serdata<T>::shrink(size_t requested_size)
+{
+  size_t n_pad_bytes = (0 - requested_size) % 4;
+  assert(requested_size + n_pad_bytes <= m_size);
+  m_size = requested_size + n_pad_bytes;
+
+  /* the serdata may stay in a reader history or writer cache for a long time, so a buffer of which
+     more than half would remain unused is replaced by one that fits */
+  if (m_data != m_inline_data.get() && m_capacity - m_size > m_size && m_capacity - m_size >= 256) {
+    unsigned char *data;
+    size_t capacity;
+    if (m_size <= inline_data_size) {
+      data = m_inline_data.get();
+      capacity = inline_data_size;
+    } else {
+      data = static_cast<unsigned char*>(pool().allocate(m_size, &capacity));
+    }
+    memcpy(data, m_data, requested_size);
+    release_data();
+    m_data = data;
+    m_capacity = capacity;
   }
 
-  hash ^= type->serdata_basehash;
-  hash_populated = true;
+  std::memset(calc_offset(m_data, static_cast<ptrdiff_t>(requested_size)), '\0', n_pad_bytes);
 }
 
 template <typename T>
@@ -876,8 +1098,15 @@ void ddscxx_serdata<T>::populate_hash()
   if (hash_populated)
     return;
 
-  populate_hash(*getT());
-  assert(hash_populated);
+  /* the hash is only used in memory, so instead of the md5 hash of the key, a cheaper hash of the
+     key is used, the md5 hash is only calculated when the keyhash is requested by serdata_get_keyhash */
+  if (!key_md5_hashed())
+    hash = org::eclipse::cyclonedds::topic::key_hash(key());
+  else
+    memcpy(&(hash), key().value, 4);
+
+  hash ^= type->serdata_basehash;
+  hash_populated = true;
 }
 
 template <typename T>
@@ -886,10 +1115,11 @@ T* ddscxx_serdata<T>::setT(const T* toset)
   assert(toset);
   T* t = m_t.load(std::memory_order_acquire);
   if (t == nullptr) {
-    t = new T(*toset);
+    void* storage = m_inline_sample.claim();
+    t = storage ? new (storage) T(*toset) : new T(*toset);
     T* exp = nullptr;
     if (!m_t.compare_exchange_strong(exp, t, std::memory_order_seq_cst)) {
-      delete t;
+      release_sample(t, false);
       t = exp;
     }
   } else {
@@ -911,40 +1141,82 @@ T* ddscxx_serdata<T>::getT(bool force_deserialization) {
 
 template <typename T>
 void ddscxx_serdata<T>::deserialize_and_update_sample(uint8_t * buffer, size_t sz, T *& t, bool force_deserialization) {
-  t = new T();
+  // only samples of received data are recycled, and only a full deserialization overwrites all
+  // the contents of a recycled sample
+  bool recycle = force_deserialization && kind == SDK_DATA;
+  t = acquire_sample(recycle);
   // if deserialization failed
   if (force_deserialization &&
       !deserialize_sample_from_buffer(buffer, sz, *t, kind)) {
-    delete t;
+    release_sample(t, recycle);
     t = nullptr;
   }
 
   T* exp = nullptr;
   if (!m_t.compare_exchange_strong(exp, t, std::memory_order_seq_cst)) {
-    delete t;
+    release_sample(t, recycle);
     t = exp;
+  } else {
+    m_t_recycled = recycle && t != nullptr;
   }
 }
 
+template <typename T>
+T* ddscxx_serdata<T>::acquire_sample(bool& recycle)
+{
+  auto &pool = org::eclipse::cyclonedds::topic::sample_pool<T>::instance();
+  recycle = recycle && pool.enabled();
+  if (recycle)
+    return pool.acquire();
+  void* storage = m_inline_sample.claim();
+  return storage ? new (storage) T() : new T();
+}
+
+template <typename T>
+void ddscxx_serdata<T>::release_sample(T* t, bool recycled)
+{
+  auto &pool = org::eclipse::cyclonedds::topic::sample_pool<T>::instance();
+  if (m_inline_sample.contains(t))
+    t->~T();
+  else if (recycled)
+    pool.release(t);
+  else
+    delete t;
+}
+
+template <typename T>
+bool ddscxx_serdata<T>::extractT(T& to, bool take)
+{
+  T* t = getT();
+  if (t == nullptr)
+    return false;
+
+  /* a serdata that is taken and is referenced only by the reader history is freed after it is
+     taken, so its sample can be moved out of it, unless it is memory of a loan */
+  if (take && loan == nullptr && ddsrt_atomic_ld32(&refc) == 1)
+    to = std::move(*t);
+  else
+    to = *t;
+  return true;
+}
+
 template<typename T>
 void ddscxx_serdata<T>::setLoan(dds_loaned_sample_t *newloan)
 {
   T *t = m_t.load(std::memory_order_acquire);
   if (!loan || t != loan->sample_ptr)
-    delete t;
+    release_sample(t, m_t_recycled);
   if (loan)
     dds_loaned_sample_unref(loan);
 
   if (!m_t.compare_exchange_strong(t, static_cast<T*>(newloan->sample_ptr), std::memory_order_seq_cst))
     ISOCPP_THROW_EXCEPTION(ISOCPP_ERROR,"Could not store loaned sample.");
+  m_t_recycled = false;
 
   dds_loaned_sample_ref(newloan);
   loan = newloan;
 }
 
-template <typename T, class S>
-class ddscxx_sertype;
-
 template <typename T, class S>
 void sertype_free(ddsi_sertype* tpcmn)
 {
@@ -1003,22 +1275,41 @@ void sertype_free_samples(
   }
 }
 
-template <typename T>
+template <typename T, class S>
 bool sertype_equal(
   const ddsi_sertype* acmn, const ddsi_sertype* bcmn)
 {
-  /* A bit of a guess: types with the same name & type name are really the same if they have
-   the same type support identifier as well */
-  (void)acmn;
-  (void)bcmn;
-  return true;
+  /* identical ops mean identical types and data representations, what remains is whether
+     the sertypes were created with the same properties */
+  return acmn->ops == bcmn->ops
+      && strcmp(acmn->type_name, bcmn->type_name) == 0
+      && acmn->allowed_data_representation == bcmn->allowed_data_representation
+      && acmn->min_xcdrv == bcmn->min_xcdrv
+      && acmn->data_type_props == bcmn->data_type_props;
 }
 
-template <typename T>
-uint32_t sertype_hash(const ddsi_sertype* tpcmn)
+template <typename T, class S>
+uint32_t calc_sertype_hash()
 {
-  (void)tpcmn;
-  return 0x0;
+  uint16_t hdr[DDSI_RTPS_HEADER_SIZE/sizeof(uint16_t)];
+  (void) write_header<T,S>(hdr);
+  const uint16_t encoding = hdr[0];
+#ifdef DDSCXX_HAS_TYPELIB
+  const unsigned char *type_info = TopicTraits<T>::type_info_blob();
+  const size_t type_info_sz = type_info ? TopicTraits<T>::type_info_blob_sz() : 0;
+#else
+  const unsigned char *type_info = nullptr;
+  const size_t type_info_sz = 0;
+#endif
+  return org::eclipse::cyclonedds::topic::type_hash(TopicTraits<T>::getTypeName(), type_info, type_info_sz, encoding);
+}
+
+template <typename T, class S>
+uint32_t sertype_hash(const ddsi_sertype*)
+{
+  /* the hash only depends on the type and the data representation, so it is calculated once */
+  static const uint32_t h = calc_sertype_hash<T,S>();
+  return h;
 }
 
 template <typename T, class S>
@@ -1065,8 +1356,8 @@ struct ddscxx_sertype_ops: public ddsi_sertype_ops {
   sertype_zero_samples<T>,
   sertype_realloc_samples<T>,
   sertype_free_samples<T>,
-  sertype_equal<T>,
-  sertype_hash<T>,
+  sertype_equal<T,S>,
+  sertype_hash<T,S>,
   #ifdef DDSCXX_HAS_TYPELIB
   TopicTraits<T>::getTypeId,
   TopicTraits<T>::getTypeMap,
@@ -1089,8 +1380,62 @@ public:
   static const ddscxx_sertype_ops<T,S> sertype_ops;
   static const ddscxx_serdata_ops<T,S> serdata_ops;
   ddscxx_sertype();
+
+  /**
+   * @brief
+   * Returns the buffer size with which samples of this type are serialized in a single pass.
+   *
+   * This is learned from the samples written through this type, and is 0 until the first sample is written.
+   *
+   * @return The size hint (excluding the encoding header).
+   */
+  size_t size_hint() const { return m_size_hint.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief
+   * Updates the size hint with the serialized size of a sample.
+   *
+   * The hint grows to the largest sample size plus some headroom, and shrinks again when samples
+   * are consistently much smaller, so that a single large sample does not inflate all buffers.
+   * It only shrinks after a run of small samples, so alternating sample sizes do not make it flip
+   * back and forth.
+   *
+   * @param[in] sz The serialized size of the sample (excluding the encoding header).
+   */
+  void update_size_hint(size_t sz) const;
+
+private:
+  static constexpr uint32_t size_hint_shrink_run = 16;  //number of consecutive small samples after which the hint shrinks
+  mutable std::atomic<size_t> m_size_hint{0};
+  mutable std::atomic<uint32_t> m_small_samples{0};
+  mutable std::atomic<size_t> m_small_max{0};
 };
 
+template <typename T, class S>
+constexpr uint32_t ddscxx_sertype<T,S>::size_hint_shrink_run;
+
+template <typename T, class S>
+void ddscxx_sertype<T,S>::update_size_hint(size_t sz) const
+{
+  /* the counters are only approximate when samples are written concurrently, which is harmless
+     as the hint only sizes the first serialization attempt */
+  size_t hint = m_size_hint.load(std::memory_order_relaxed);
+  if (sz > hint) {
+    m_size_hint.store(sz + sz / 8 + 8, std::memory_order_relaxed);
+    m_small_samples.store(0, std::memory_order_relaxed);
+  } else if (sz >= hint / 4) {
+    m_small_samples.store(0, std::memory_order_relaxed);
+  } else {
+    size_t small_max = m_small_max.load(std::memory_order_relaxed);
+    if (m_small_samples.fetch_add(1, std::memory_order_relaxed) == 0 || sz > small_max)
+      m_small_max.store(small_max = sz, std::memory_order_relaxed);
+    if (m_small_samples.load(std::memory_order_relaxed) >= size_hint_shrink_run) {
+      m_size_hint.store(small_max + small_max / 8 + 8, std::memory_order_relaxed);
+      m_small_samples.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
 template <typename T, class S>
 const ddscxx_sertype_ops<T,S> ddscxx_sertype<T,S>::sertype_ops;
 
@@ -1120,4 +1465,95 @@ ddscxx_sertype<T,S>::ddscxx_sertype()
       0);
 }
 
+/**
+ * @brief
+ * Creates the serdata of a sample of which the key is already known.
+ *
+ * Used for writing samples of registered instances, to skip deriving the key from the sample.
+ * In debug builds the key is checked against that of the sample.
+ *
+ * @param[in] type The sertype of the serdata, created by TopicTraits<T>::getSerType.
+ * @param[in] sample The sample.
+ * @param[in] key The key of the sample, as calculated by to_key.
+ * @param[in] key_md5_hashed Whether the key is the md5 hash of the serialized key, as returned by to_key.
+ *
+ * @return The serdata, or nullptr if the sample could not be serialized.
+ */
+template <typename T>
+ddsi_serdata *serdata_from_sample_and_key(
+  const ddsi_sertype* type,
+  const T& sample,
+  const ddsi_keyhash_t& key,
+  bool key_md5_hashed)
+{
+  if (type->serdata_ops == &ddscxx_sertype<T,xcdr_v2_stream>::serdata_ops)
+    return serdata_from_sample_impl<T,xcdr_v2_stream>(type, SDK_DATA, sample, &key, key_md5_hashed);
+  assert(type->serdata_ops == &ddscxx_sertype<T,xcdr_v1_stream>::serdata_ops);
+  return serdata_from_sample_impl<T,xcdr_v1_stream>(type, SDK_DATA, sample, &key, key_md5_hashed);
+}
+
+/**
+ * @brief
+ * Creates the serdata of a sample that is serialized in place by the application.
+ *
+ * The serialized data of the serdata is allocated from the serdata pool of the type, and starts
+ * with the encoding header of the data representation of the sertype. The payload following it
+ * is to be filled by the caller, after which the serdata is completed by serdata_from_loan.
+ *
+ * @param[in] type The sertype of the serdata, created by TopicTraits<T>::getSerType.
+ * @param[in] payload_size The size of the payload, excluding the encoding header.
+ * @param[out] payload The start of the payload.
+ * @param[out] version The encoding in which the payload is to be serialized.
+ *
+ * @return The serdata.
+ */
+template <typename T>
+ddsi_serdata *serdata_loan(
+  const ddsi_sertype* type,
+  size_t payload_size,
+  unsigned char*& payload,
+  encoding_version& version)
+{
+  auto d = new ddscxx_serdata<T>(type, SDK_DATA);
+  d->resize(payload_size + DDSI_RTPS_HEADER_SIZE);
+  if (type->serdata_ops == &ddscxx_sertype<T,xcdr_v2_stream>::serdata_ops) {
+    (void) write_header<T,xcdr_v2_stream>(d->data());
+    version = encoding_version::xcdr_v2;
+  } else {
+    assert(type->serdata_ops == &ddscxx_sertype<T,xcdr_v1_stream>::serdata_ops);
+    (void) write_header<T,xcdr_v1_stream>(d->data());
+    version = encoding_version::xcdr_v1;
+  }
+  payload = static_cast<unsigned char*>(calc_offset(d->data(), DDSI_RTPS_HEADER_SIZE));
+  return d;
+}
+
+/**
+ * @brief
+ * Completes a serdata created by serdata_loan, once its payload has been filled.
+ *
+ * The serialized data is shrunk to the size of the payload that was actually written, and the
+ * key is read from the payload into a scratch sample, so the serdata does not need to be copied,
+ * and does not keep a deserialized sample.
+ *
+ * @param[in] dcmn The serdata, as returned by serdata_loan.
+ * @param[in] payload_size The size of the filled payload, at most the size it was created with.
+ *
+ * @return Whether the key could be read from the payload.
+ */
+template <typename T>
+bool serdata_from_loan(ddsi_serdata* dcmn, size_t payload_size)
+{
+  auto d = static_cast<ddscxx_serdata<T>*>(dcmn);
+  d->shrink(payload_size + DDSI_RTPS_HEADER_SIZE);
+  (void) finish_header<T>(d->data(), payload_size);
+
+  const T* t = serdata_key_sample(d);
+  if (t == nullptr)
+    return false;
+  d->key_md5_hashed() = to_key(*t, d->key());
+  d->populate_hash();
+  return true;
+}
+
 #endif  // DDSCXXDATATOPIC_HPP_
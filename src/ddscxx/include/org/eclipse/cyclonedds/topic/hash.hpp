@@ -31,6 +31,12 @@ namespace org
         bool OMG_DDS_API simple_key(const std::vector<unsigned char>& in, ddsi_keyhash_t& out);
 
         bool OMG_DDS_API complex_key(const std::vector<unsigned char>& in, ddsi_keyhash_t& out);
+
+        bool OMG_DDS_API complex_key(const unsigned char* in, size_t sz, ddsi_keyhash_t& out);
+
+        uint32_t OMG_DDS_API key_hash(const ddsi_keyhash_t& key);
+
+        uint32_t OMG_DDS_API type_hash(const char* type_name, const unsigned char* type_info, size_t type_info_sz, uint16_t encoding);
       }
     }
   }
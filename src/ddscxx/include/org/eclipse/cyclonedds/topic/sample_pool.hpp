@@ -0,0 +1,169 @@
+// Copyright(c) 2024 ZettaScale Technology and others
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+// v. 1.0 which is available at
+// http://www.eclipse.org/org/documents/edl-v10.php.
+//
+// SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_TOPIC_SAMPLE_POOL_HPP_
+#define CYCLONEDDS_TOPIC_SAMPLE_POOL_HPP_
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "org/eclipse/cyclonedds/topic/TopicTraits.hpp"
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace topic
+{
+
+/**
+ * @brief
+ * Pool of samples which received data is deserialized into.
+ *
+ * Samples are taken from the pool when data of TOPIC is received, and are returned to it when
+ * the last reference to the data is dropped, for example when the last SampleRef or
+ * LoanedSamples referring to it goes out of scope.
+ * As a returned sample keeps the memory of its strings and vectors, deserializing into it
+ * does not need to allocate memory again as long as the received data fits.
+ *
+ * Only samples that received data is deserialized into are recycled, not the copies of written
+ * samples. Recycling is disabled by default, and is only done for types for which the
+ * isRecyclable trait is true. Since all readers of TOPIC share the received data, they also
+ * share the pool. It is enabled through any of these readers, e.g.:
+ * @code{.cpp}
+ * reader->sample_recycling(64);
+ * @endcode
+ */
+template <class TOPIC>
+class sample_pool
+{
+public:
+    /**
+     * @brief Returns the pool for TOPIC.
+     *
+     * The pool is never destroyed, so that samples can be returned to it at any time.
+     */
+    static sample_pool &instance()
+    {
+        static sample_pool *pool = new sample_pool();
+        return *pool;
+    }
+
+    /**
+     * @brief Returns whether received samples are taken from the pool.
+     */
+    bool enabled() const
+    {
+        return TopicTraits<TOPIC>::isRecyclable() && m_capacity.load(std::memory_order_relaxed) > 0;
+    }
+
+    /**
+     * @brief Returns the maximum number of unused samples kept by the pool.
+     */
+    size_t capacity() const
+    {
+        return m_capacity.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sets the maximum number of unused samples kept by the pool.
+     *
+     * Unused samples beyond the new capacity are released, a capacity of 0 disables recycling.
+     *
+     * @param[in] max_samples The maximum number of unused samples.
+     */
+    void capacity(size_t max_samples)
+    {
+        std::vector<TOPIC*> excess;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_capacity.store(max_samples, std::memory_order_relaxed);
+            while (m_free.size() > max_samples) {
+                excess.push_back(m_free.back());
+                m_free.pop_back();
+            }
+        }
+        for (auto t:excess)
+            delete t;
+    }
+
+    /**
+     * @brief Returns the number of unused samples in the pool.
+     */
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_free.size();
+    }
+
+    /**
+     * @brief Takes a sample from the pool.
+     *
+     * The contents of the sample are those of a previously received sample.
+     *
+     * @return A previously used sample, or a newly constructed one if the pool is empty.
+     */
+    TOPIC *acquire()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_free.empty()) {
+                TOPIC *t = m_free.back();
+                m_free.pop_back();
+                return t;
+            }
+        }
+        return new TOPIC();
+    }
+
+    /**
+     * @brief Returns a sample to the pool.
+     *
+     * The sample is deleted if the pool is full.
+     *
+     * @param[in] t The sample to return.
+     */
+    void release(TOPIC *t)
+    {
+        if (t == nullptr)
+            return;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_free.size() < m_capacity.load(std::memory_order_relaxed)) {
+                m_free.push_back(t);
+                return;
+            }
+        }
+        delete t;
+    }
+
+private:
+    sample_pool() = default;
+    sample_pool(const sample_pool&) = delete;
+    sample_pool& operator=(const sample_pool&) = delete;
+
+    mutable std::mutex m_mutex;
+    std::vector<TOPIC*> m_free;
+    std::atomic<size_t> m_capacity{0};
+};
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_TOPIC_SAMPLE_POOL_HPP_ */
@@ -0,0 +1,382 @@
+// Copyright(c) 2024 ZettaScale Technology and others
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+// v. 1.0 which is available at
+// http://www.eclipse.org/org/documents/edl-v10.php.
+//
+// SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_TOPIC_SAMPLE_VIEW_HPP_
+#define CYCLONEDDS_TOPIC_SAMPLE_VIEW_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "org/eclipse/cyclonedds/topic/datatopic.hpp"
+
+#if DDSCXX_USE_BOOST
+#include <boost/utility/string_view.hpp>
+#else
+#include <string_view>
+#endif
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace topic
+{
+
+/**
+ * @brief
+ * Maps a topic type to the view class generated for it.
+ *
+ * Specialized by idlcxx for all topic types when it is run with "-f views".
+ */
+template <class TOPIC>
+struct view_traits;
+
+/**
+ * @brief
+ * Non-owning reference to the characters of a string member of a view.
+ */
+#if DDSCXX_USE_BOOST
+typedef boost::string_view string_view;
+#else
+typedef std::string_view string_view;
+#endif
+
+/**
+ * @brief
+ * Non-owning reference to the elements of a sequence member of a view.
+ */
+template <typename E>
+class sequence_view
+{
+public:
+    typedef E value_type;
+    typedef const E* const_iterator;
+
+    sequence_view() = default;
+    sequence_view(const E *data, size_t size) : m_data(data), m_size(size) { }
+
+    const E *data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    const E &operator[](size_t i) const { return m_data[i]; }
+    const_iterator begin() const { return m_data; }
+    const_iterator end() const { return m_data + m_size; }
+
+private:
+    const E *m_data = nullptr;
+    size_t m_size = 0;
+};
+
+/**
+ * @brief
+ * Read-only view on a received sample, which only deserializes the members that are accessed.
+ *
+ * This is the base class of the TYPE_view classes generated by idlcxx when it is run with
+ * "-f views", which have a getter for each member of TYPE, e.g.:
+ * @code{.cpp}
+ * dds::sub::LoanedSamples<MyType> samples = reader.take();
+ * for (uint32_t i = 0; i < samples.length(); i++) {
+ *     MyType_view view = samples.delegate()->view(i);
+ *     route(view.destination());
+ * }
+ * @endcode
+ *
+ * Members of final types without optional members are located and read one by one: the offsets
+ * of the members at the start of the type that have a fixed size are learned once per type, the
+ * offsets of the members after those are found by reading the members in front of them, and are
+ * remembered by the view. Other types are deserialized completely on the first access.
+ * If the received data was already deserialized, for example because it was read before, all
+ * accesses go to the deserialized sample.
+ *
+ * For string members and sequences of primitive types, the view also has NAME_view getters, which
+ * return a string_view or sequence_view referring to the received data without copying it, if the
+ * data can be used as is: it must not need byte swapping and must be aligned in memory. Otherwise
+ * they refer to the member after it has been deserialized. The references stay valid as long as
+ * the view exists.
+ *
+ * A view keeps a reference to the received data, it is therefore valid after the LoanedSamples
+ * it was taken from goes out of scope. The sample the members are deserialized into is only
+ * constructed when a member is first deserialized, and is not copied with the view: a copy reads
+ * its members again. Views are not thread-safe, each thread should use its own copy of a view.
+ */
+template <class TOPIC>
+class sample_view
+{
+public:
+    sample_view(const sample_view &other) :
+        m_serdata(static_cast<ddscxx_serdata<TOPIC>*>(ddsi_serdata_ref(other.m_serdata))),
+        m_lazy(other.m_lazy),
+        m_fixed_prefix(other.m_fixed_prefix),
+        m_version(other.m_version),
+        m_endianness(other.m_endianness),
+        m_offsets(other.m_offsets),
+        m_decoded(other.m_decoded.size(), false)
+    {
+    }
+
+    sample_view &operator=(const sample_view &other)
+    {
+        if (this != &other) {
+            ddsi_serdata_unref(m_serdata);
+            m_serdata = static_cast<ddscxx_serdata<TOPIC>*>(ddsi_serdata_ref(other.m_serdata));
+            m_lazy = other.m_lazy;
+            m_fixed_prefix = other.m_fixed_prefix;
+            m_version = other.m_version;
+            m_endianness = other.m_endianness;
+            m_sample.reset();
+            m_offsets = other.m_offsets;
+            m_decoded.assign(other.m_decoded.size(), false);
+        }
+        return *this;
+    }
+
+    ~sample_view()
+    {
+        ddsi_serdata_unref(m_serdata);
+    }
+
+    /**
+     * @brief Returns the completely deserialized sample.
+     *
+     * @throws dds::core::Error If the received data could not be deserialized.
+     */
+    const TOPIC &full_sample() const
+    {
+        const TOPIC *t = m_serdata->getT();
+        if (t == nullptr)
+            ISOCPP_THROW_EXCEPTION(ISOCPP_ERROR, "Could not deserialize sample.");
+        return *t;
+    }
+
+protected:
+    /**
+     * @brief Constructs a view on received data.
+     *
+     * @param[in] sd The received data.
+     * @param[in] lazy Whether the members of TOPIC can be read one by one.
+     * @param[in] fixed_prefix The number of members at the start of TOPIC that have a fixed size.
+     */
+    sample_view(ddscxx_serdata<TOPIC> *sd, bool lazy, size_t fixed_prefix) :
+        m_serdata(static_cast<ddscxx_serdata<TOPIC>*>(ddsi_serdata_ref(sd))),
+        m_lazy(lazy),
+        m_fixed_prefix(fixed_prefix)
+    {
+        if (m_lazy && (sd->peekT() != nullptr || !read_header<TOPIC>(sd->data(), m_version, m_endianness)))
+            m_lazy = false;
+        if (!m_lazy)
+            return;
+
+        auto &l = type_layout();
+        m_decoded.assign(l.members.size(), false);
+        auto &prefix = l.prefixes[prefix_index()];
+        if (prefix.known.load(std::memory_order_acquire))
+            m_offsets = prefix.offsets;
+        else
+            m_offsets.push_back(0);
+    }
+
+    /**
+     * @brief Returns a sample of which at least the member at index has been deserialized.
+     *
+     * @param[in] index The position of the member in TOPIC, counting the members of base types first.
+     *
+     * @throws dds::core::Error If the member could not be deserialized.
+     */
+    const TOPIC &decoded_member(size_t index) const
+    {
+        if (!m_lazy || m_serdata->peekT() != nullptr)
+            return full_sample();
+        if (m_decoded[index])
+            return *m_sample;
+
+        if (!read_until(index, true))
+            ISOCPP_THROW_EXCEPTION(ISOCPP_ERROR, "Could not deserialize member of sample.");
+        return *m_sample;
+    }
+
+    /**
+     * @brief Returns a reference to the characters of a string member.
+     *
+     * @param[in] index The position of the member in TOPIC, counting the members of base types first.
+     * @param[in] getter The getter of the member, used if the member needs to be deserialized.
+     *
+     * @throws dds::core::Error If the member could not be deserialized.
+     */
+    template <typename C, class B>
+    string_view string_member(size_t index, const C &(B::*getter)() const) const
+    {
+        const void *data = nullptr;
+        uint32_t length = 0;
+        if (serialized_member(index, 1, data, length))
+            return string_view(static_cast<const char*>(data), length > 0 ? length - 1 : 0); //without the terminating 0
+        const C &c = (decoded_member(index).*getter)();
+        return string_view(c.data(), c.size());
+    }
+
+    /**
+     * @brief Returns a reference to the elements of a sequence member of primitive type E.
+     *
+     * @param[in] index The position of the member in TOPIC, counting the members of base types first.
+     * @param[in] getter The getter of the member, used if the member needs to be deserialized.
+     *
+     * @throws dds::core::Error If the member could not be deserialized.
+     */
+    template <typename E, typename C, class B>
+    sequence_view<E> sequence_member(size_t index, const C &(B::*getter)() const) const
+    {
+        const void *data = nullptr;
+        uint32_t length = 0;
+        if (serialized_member(index, sizeof(E), data, length))
+            return sequence_view<E>(static_cast<const E*>(data), length);
+        const C &c = (decoded_member(index).*getter)();
+        return sequence_view<E>(c.data(), c.size());
+    }
+
+private:
+    struct prefix_layout {
+        std::atomic_bool known{false};
+        std::vector<size_t> offsets;
+    };
+
+    struct layout {
+        layout()
+        {
+            auto prop = org::eclipse::cyclonedds::core::cdr::get_type_props<TOPIC>().data()->first_entity(key_mode::not_key);
+            while (prop) {
+                members.push_back(prop);
+                prop = prop->next_entity(key_mode::not_key);
+            }
+        }
+
+        std::vector<const org::eclipse::cyclonedds::core::cdr::entity_properties_t*> members;
+        std::mutex mtx;
+        prefix_layout prefixes[2];  //xcdr_v1 and xcdr_v2 align differently
+    };
+
+    static layout &type_layout()
+    {
+        static layout l;
+        return l;
+    }
+
+    size_t prefix_index() const
+    {
+        return m_version == encoding_version::xcdr_v1 ? 0 : 1;
+    }
+
+    template <class S>
+    bool read_at(S &str, size_t index) const
+    {
+        str.position(m_offsets[index]);
+        str.alignment(0);
+        if (!m_sample)
+            m_sample.reset(new TOPIC());
+        if (!read_member(str, *m_sample, type_layout().members[index]))
+            return false;
+        m_decoded[index] = true;
+        return true;
+    }
+
+    bool read_until(size_t index, bool including) const
+    {
+        switch (m_version) {
+            case encoding_version::xcdr_v1:
+                return read_until<xcdr_v1_stream>(index, including);
+            case encoding_version::xcdr_v2:
+                return read_until<xcdr_v2_stream>(index, including);
+            default:
+                return false;
+        }
+    }
+
+    /* reads the members in front of the member at index until its offset is known, and the member
+       itself if including is set */
+    template <class S>
+    bool read_until(size_t index, bool including) const
+    {
+        S str(m_endianness);
+        str.set_buffer(calc_offset(m_serdata->data(), DDSI_RTPS_HEADER_SIZE), m_serdata->size() - DDSI_RTPS_HEADER_SIZE);
+        str.set_mode(cdr_stream::stream_mode::read, key_mode::not_key);
+
+        //the offset of a member is where the member in front of it ends
+        while (m_offsets.size() <= index) {
+            if (!read_at(str, m_offsets.size() - 1))
+                return false;
+            m_offsets.push_back(str.position());
+        }
+        if (including && !m_decoded[index] && !read_at(str, index))
+            return false;
+
+        //the offsets of the fixed size members do not depend on the contents, so they are shared
+        auto &l = type_layout();
+        auto &prefix = l.prefixes[prefix_index()];
+        const size_t n_shared = std::min(m_fixed_prefix + 1, l.members.size());
+        if (m_offsets.size() >= n_shared && !prefix.known.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(l.mtx);
+            if (!prefix.known.load(std::memory_order_relaxed)) {
+                prefix.offsets.assign(m_offsets.begin(), m_offsets.begin() + static_cast<std::ptrdiff_t>(n_shared));
+                prefix.known.store(true, std::memory_order_release);
+            }
+        }
+        return true;
+    }
+
+    /* locates the length and the contents of a string or a sequence of primitives in the received
+       data, which can only be referred to directly if it needs no byte swapping and is aligned */
+    bool serialized_member(size_t index, size_t elem_size, const void *&data, uint32_t &length) const
+    {
+        if (!m_lazy || m_serdata->peekT() != nullptr
+         || (elem_size > 1 && m_endianness != native_endianness())
+         || !read_until(index, false))
+            return false;
+
+        const size_t max_align = m_version == encoding_version::xcdr_v1 ? 8 : 4;
+        const size_t size = m_serdata->size() - DDSI_RTPS_HEADER_SIZE;
+        auto cdr = static_cast<const char*>(calc_offset(m_serdata->data(), DDSI_RTPS_HEADER_SIZE));
+        size_t pos = (m_offsets[index] + 3) & ~size_t(3);
+        if (pos > size || size - pos < sizeof(length))
+            return false;
+        memcpy(&length, cdr + pos, sizeof(length));
+        if (m_endianness != native_endianness())
+            org::eclipse::cyclonedds::core::cdr::byte_swap(&length);
+
+        const size_t al = std::min(elem_size, max_align);
+        pos = (pos + sizeof(length) + al - 1) / al * al;
+        if (pos > size || length > (size - pos) / elem_size)
+            return false;
+        data = cdr + pos;
+        return reinterpret_cast<uintptr_t>(data) % elem_size == 0;
+    }
+
+    ddscxx_serdata<TOPIC> *m_serdata;
+    bool m_lazy;
+    size_t m_fixed_prefix;
+    encoding_version m_version = encoding_version::xcdr_v1;
+    endianness m_endianness = native_endianness();
+    mutable std::unique_ptr<TOPIC> m_sample;  //only constructed once a member is deserialized
+    mutable std::vector<size_t> m_offsets;
+    mutable std::vector<bool> m_decoded;
+};
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_TOPIC_SAMPLE_VIEW_HPP_ */
@@ -0,0 +1,409 @@
+// Copyright(c) 2024 ZettaScale Technology and others
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+// v. 1.0 which is available at
+// http://www.eclipse.org/org/documents/edl-v10.php.
+//
+// SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+
+/**
+ * @file
+ */
+
+#ifndef CYCLONEDDS_TOPIC_SERDATA_POOL_HPP_
+#define CYCLONEDDS_TOPIC_SERDATA_POOL_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "org/eclipse/cyclonedds/core/ReportUtils.hpp"
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace topic
+{
+
+/**
+ * @brief
+ * Source of the memory of the serdata pools.
+ *
+ * The default resource uses the global operator new and delete, a different resource, e.g. one
+ * backed by huge pages, can be set for the pool of a type through serdata_pool::resource.
+ * The resource is only used while pooling is enabled.
+ */
+class memory_resource
+{
+public:
+    virtual ~memory_resource() = default;
+
+    /**
+     * @brief Allocates a block of memory.
+     *
+     * @param[in] bytes The size of the block.
+     * @param[in] alignment The required alignment of the block.
+     *
+     * @return The block, failure to allocate must be reported by throwing std::bad_alloc.
+     */
+    virtual void *allocate(size_t bytes, size_t alignment) = 0;
+
+    /**
+     * @brief Releases a block of memory obtained from allocate.
+     *
+     * @param[in] p The block.
+     * @param[in] bytes The size that was passed to allocate.
+     * @param[in] alignment The alignment that was passed to allocate.
+     */
+    virtual void deallocate(void *p, size_t bytes, size_t alignment) = 0;
+
+    /**
+     * @brief Returns the resource using the global operator new and delete.
+     */
+    static memory_resource *new_delete_resource()
+    {
+        class new_delete : public memory_resource
+        {
+        public:
+            void *allocate(size_t bytes, size_t) { return ::operator new(bytes); }
+            void deallocate(void *p, size_t, size_t) { ::operator delete(p); }
+        };
+        static new_delete resource;
+        return &resource;
+    }
+};
+
+/**
+ * @brief
+ * Counters of the blocks of a serdata pool.
+ */
+struct serdata_pool_statistics
+{
+    uint64_t allocations;   /**< number of blocks obtained from the memory resource, while pooling was enabled */
+    uint64_t deallocations; /**< number of those blocks returned to the memory resource */
+};
+
+/**
+ * @brief
+ * Pool of the memory of the serdata of TOPIC and of their serialized data.
+ *
+ * Each sample written or received creates a serdata and a buffer for its serialized data, and when
+ * the pool is enabled both are taken from it and returned to it when the serdata is freed.
+ * Requests are then rounded up to a power of two between 64 bytes and 64 kilobytes, larger requests
+ * are passed on to the memory resource directly.
+ * Each thread keeps a small number of free blocks of each size, so that most requests do not need
+ * to take the lock of the pool, and blocks are exchanged with the pool in batches.
+ * While the pool is disabled, requests are allocated with their exact size by the global operator
+ * new, and are not counted. Each block starts with a small header recording its size and where it
+ * came from, so that it goes back there even if pooling is enabled or disabled while it is in use.
+ *
+ * Pooling is disabled by default, it is enabled by setting the capacity, e.g.:
+ * @code{.cpp}
+ * serdata_pool<MyType>::instance().capacity(256);
+ * @endcode
+ * or by letting the readers and writers of TOPIC size the pool from their ResourceLimits QoS:
+ * @code{.cpp}
+ * serdata_pool<MyType>::instance().follow_resource_limits(true);
+ * @endcode
+ * Once the number of samples in use stops growing, the allocation counters of statistics() stop
+ * increasing.
+ */
+template <class TOPIC>
+class serdata_pool
+{
+public:
+    /**
+     * @brief Returns the pool for TOPIC.
+     *
+     * The pool is never destroyed, so that memory can be returned to it at any time.
+     */
+    static serdata_pool &instance()
+    {
+        static serdata_pool *pool = new serdata_pool();
+        return *pool;
+    }
+
+    /**
+     * @brief Returns whether memory is taken from the pool.
+     */
+    bool enabled() const
+    {
+        return m_capacity.load(std::memory_order_relaxed) > 0;
+    }
+
+    /**
+     * @brief Returns the maximum number of unused blocks of each size kept by the pool.
+     */
+    size_t capacity() const
+    {
+        return m_capacity.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sets the maximum number of unused blocks of each size kept by the pool.
+     *
+     * Unused blocks beyond the new capacity are released, a capacity of 0 disables pooling.
+     * The unused blocks held by the calling thread are returned to the pool first, those held by
+     * other threads are returned by these threads when they need to, or when they exit.
+     *
+     * @param[in] max_blocks The maximum number of unused blocks of each size.
+     */
+    void capacity(size_t max_blocks)
+    {
+        thread_cache &tc = local_cache();
+        for (size_t c = 0; c < n_classes; c++)
+            flush(tc, c, tc.count[c]);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_capacity.store(max_blocks, std::memory_order_relaxed);
+        for (size_t c = 0; c < n_classes; c++) {
+            while (m_free[c].size() > max_blocks) {
+                release_to_resource(m_free[c].back());
+                m_free[c].pop_back();
+            }
+        }
+    }
+
+    /**
+     * @brief Returns whether readers and writers of TOPIC size the pool.
+     */
+    bool follow_resource_limits() const
+    {
+        return m_follow_limits.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sets whether readers and writers of TOPIC size the pool.
+     *
+     * If set, creating a reader or writer grows the capacity of the pool to the max_samples of its
+     * ResourceLimits QoS policy, unless that is unlimited.
+     *
+     * @param[in] follow Whether to follow the ResourceLimits QoS policy.
+     */
+    void follow_resource_limits(bool follow)
+    {
+        m_follow_limits.store(follow, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Grows the capacity of the pool for a reader or writer of TOPIC.
+     *
+     * Does nothing unless follow_resource_limits is set.
+     *
+     * @param[in] max_samples The max_samples of the ResourceLimits QoS policy, negative if unlimited.
+     */
+    void reserve(int32_t max_samples)
+    {
+        if (!follow_resource_limits() || max_samples <= 0)
+            return;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_capacity.load(std::memory_order_relaxed) < static_cast<size_t>(max_samples))
+            m_capacity.store(static_cast<size_t>(max_samples), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the memory resource the pool takes its memory from.
+     */
+    memory_resource *resource() const
+    {
+        return m_resource.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Sets the memory resource the pool takes its memory from.
+     *
+     * As blocks are returned to the resource they were obtained from, the resource can only be
+     * changed before the pool hands out memory, or after all of it has been returned to the resource.
+     *
+     * @param[in] mr The memory resource, or nullptr for the default resource.
+     *
+     * @throw dds::core::PreconditionNotMetError If the pool holds memory of the current resource.
+     */
+    void resource(memory_resource *mr)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_allocations.load(std::memory_order_relaxed) != m_deallocations.load(std::memory_order_relaxed))
+            ISOCPP_THROW_EXCEPTION(ISOCPP_PRECONDITION_NOT_MET_ERROR, "Memory resource of serdata pool is in use.");
+        m_resource.store(mr ? mr : memory_resource::new_delete_resource(), std::memory_order_release);
+    }
+
+    /**
+     * @brief Returns the counters of the blocks obtained from and returned to the memory resource.
+     */
+    serdata_pool_statistics statistics() const
+    {
+        serdata_pool_statistics s;
+        s.allocations = m_allocations.load(std::memory_order_relaxed);
+        s.deallocations = m_deallocations.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    /**
+     * @brief Takes a block of at least bytes bytes from the pool.
+     *
+     * @param[in] bytes The requested size.
+     * @param[out] usable If not nullptr, set to the number of bytes that can be used, which is more
+     *                    than requested if the request was rounded up.
+     *
+     * @return The block, which must be returned through deallocate.
+     */
+    void *allocate(size_t bytes, size_t *usable = nullptr)
+    {
+        block_header *b;
+        if (!enabled()) {
+            b = static_cast<block_header*>(::operator new(header_size + bytes));
+            b->size = header_size + bytes;
+            b->pooled = false;
+        } else if (header_size + bytes > class_size(n_classes - 1)) {
+            b = obtain_from_resource(header_size + bytes);
+        } else {
+            const size_t c = size_class(header_size + bytes);
+            thread_cache &tc = local_cache();
+            if (tc.count[c] == 0)
+                refill(tc, c);
+            b = tc.count[c] > 0 ? tc.blocks[c][--tc.count[c]] : obtain_from_resource(class_size(c));
+        }
+
+        if (usable)
+            *usable = b->size - header_size;
+        return b + 1;
+    }
+
+    /**
+     * @brief Returns a block to the pool.
+     *
+     * @param[in] p The block, may be nullptr.
+     */
+    void deallocate(void *p)
+    {
+        if (p == nullptr)
+            return;
+
+        block_header *b = static_cast<block_header*>(p) - 1;
+        if (!b->pooled) {
+            ::operator delete(b);
+        } else if (enabled() && b->size <= class_size(n_classes - 1)) {
+            const size_t c = size_class(b->size);
+            thread_cache &tc = local_cache();
+            if (tc.count[c] == thread_cache_size)
+                flush(tc, c, thread_cache_size/2);
+            tc.blocks[c][tc.count[c]++] = b;
+        } else {
+            release_to_resource(b);
+        }
+    }
+
+private:
+    static const size_t min_class_shift = 6;
+    static const size_t n_classes = 11;
+    static const size_t thread_cache_size = 32;
+
+    /* the header in front of each block, the blocks obtained from the memory resource are pooled,
+       and have the size of their class unless they are too large for the pool */
+    struct alignas(alignof(std::max_align_t)) block_header
+    {
+        size_t size;  //including the header
+        bool pooled;
+    };
+    static const size_t header_size = sizeof(block_header);
+
+    struct thread_cache
+    {
+        block_header *blocks[n_classes][thread_cache_size];
+        size_t count[n_classes];
+
+        thread_cache() : count() { }
+        ~thread_cache()
+        {
+            for (size_t c = 0; c < n_classes; c++)
+                instance().flush(*this, c, count[c]);
+        }
+    };
+
+    serdata_pool() : m_resource(memory_resource::new_delete_resource()) { }
+    serdata_pool(const serdata_pool&) = delete;
+    serdata_pool& operator=(const serdata_pool&) = delete;
+
+    static size_t class_size(size_t c)
+    {
+        return static_cast<size_t>(1) << (c + min_class_shift);
+    }
+
+    static size_t size_class(size_t bytes)
+    {
+        size_t c = 0;
+        while (class_size(c) < bytes)
+            c++;
+        return c;
+    }
+
+    static thread_cache &local_cache()
+    {
+        static thread_local thread_cache tc;
+        return tc;
+    }
+
+    block_header *obtain_from_resource(size_t bytes)
+    {
+        block_header *b = static_cast<block_header*>(resource()->allocate(bytes, alignof(std::max_align_t)));
+        b->size = bytes;
+        b->pooled = true;
+        m_allocations.fetch_add(1, std::memory_order_relaxed);
+        return b;
+    }
+
+    void release_to_resource(block_header *b)
+    {
+        resource()->deallocate(b, b->size, alignof(std::max_align_t));
+        m_deallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /* takes half a thread cache worth of blocks from the pool */
+    void refill(thread_cache &tc, size_t c)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<block_header*> &free = m_free[c];
+        while (!free.empty() && tc.count[c] < thread_cache_size/2) {
+            tc.blocks[c][tc.count[c]++] = free.back();
+            free.pop_back();
+        }
+    }
+
+    /* moves n blocks from the thread cache to the pool, releasing those that do not fit */
+    void flush(thread_cache &tc, size_t c, size_t n)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<block_header*> &free = m_free[c];
+        const size_t cap = m_capacity.load(std::memory_order_relaxed);
+        for (; n > 0; n--) {
+            block_header *b = tc.blocks[c][--tc.count[c]];
+            if (free.size() < cap)
+                free.push_back(b);
+            else
+                release_to_resource(b);
+        }
+    }
+
+    std::mutex m_mutex;
+    std::vector<block_header*> m_free[n_classes];
+    std::atomic<size_t> m_capacity{0};
+    std::atomic<bool> m_follow_limits{false};
+    std::atomic<memory_resource*> m_resource;
+    std::atomic<uint64_t> m_allocations{0};
+    std::atomic<uint64_t> m_deallocations{0};
+};
+
+}
+}
+}
+}
+
+#endif /* CYCLONEDDS_TOPIC_SERDATA_POOL_HPP_ */
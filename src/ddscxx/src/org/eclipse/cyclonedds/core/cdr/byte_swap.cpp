@@ -0,0 +1,212 @@
+// Copyright(c) 2024 ZettaScale Technology and others
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+// v. 1.0 which is available at
+// http://www.eclipse.org/org/documents/edl-v10.php.
+//
+// SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+
+#include <cstring>
+#include <assert.h>
+
+#include <org/eclipse/cyclonedds/core/cdr/cdr_stream.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DDSCXX_SWAP_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define DDSCXX_SWAP_AVX2 1
+#define DDSCXX_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(_MSC_VER)
+#define DDSCXX_SWAP_AVX2 1
+#define DDSCXX_TARGET_AVX2
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+#define DDSCXX_SWAP_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace org {
+namespace eclipse {
+namespace cyclonedds {
+namespace core {
+namespace cdr {
+
+namespace {
+
+typedef void (*swap_copy_fn)(unsigned char *dst, const unsigned char *src, size_t N);
+
+/* scalar kernel, also handles the tails of the vectorized kernels */
+template<typename U>
+void swap_copy_scalar(unsigned char *dst, const unsigned char *src, size_t N)
+{
+  for (size_t i = 0; i < N; i++, dst += sizeof(U), src += sizeof(U)) {
+    U u;
+    memcpy(&u, src, sizeof(U));
+    byte_swap(&u);
+    memcpy(dst, &u, sizeof(U));
+  }
+}
+
+#if DDSCXX_SWAP_SSE2
+/* SSE2 has no byte shuffle, so the bytes are swapped by reversing the 16-bit words
+   in each element, followed by swapping the bytes in each word */
+inline __m128i swap_words_sse2(__m128i v)
+{
+  return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+template<size_t SZ>
+inline __m128i swap_sse2(__m128i v);
+
+template<>
+inline __m128i swap_sse2<2>(__m128i v)
+{
+  return swap_words_sse2(v);
+}
+
+template<>
+inline __m128i swap_sse2<4>(__m128i v)
+{
+  v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+  v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+  return swap_words_sse2(v);
+}
+
+template<>
+inline __m128i swap_sse2<8>(__m128i v)
+{
+  v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+  v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+  return swap_words_sse2(v);
+}
+
+template<typename U>
+void swap_copy_sse2(unsigned char *dst, const unsigned char *src, size_t N)
+{
+  const size_t per_vec = sizeof(__m128i)/sizeof(U);
+  for (; N >= per_vec; N -= per_vec, dst += sizeof(__m128i), src += sizeof(__m128i)) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), swap_sse2<sizeof(U)>(v));
+  }
+  swap_copy_scalar<U>(dst, src, N);
+}
+#endif
+
+#if DDSCXX_SWAP_AVX2
+template<typename U>
+DDSCXX_TARGET_AVX2 void swap_copy_avx2(unsigned char *dst, const unsigned char *src, size_t N)
+{
+  /* the shuffle works on each 128-bit lane separately, so the mask is repeated for both lanes */
+  const __m256i mask = sizeof(U) == 2 ?
+      _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                       1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14)
+    : sizeof(U) == 4 ?
+      _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                       3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+    : _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                       7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  const size_t per_vec = sizeof(__m256i)/sizeof(U);
+  for (; N >= per_vec; N -= per_vec, dst += sizeof(__m256i), src += sizeof(__m256i)) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_shuffle_epi8(v, mask));
+  }
+  swap_copy_sse2<U>(dst, src, N);
+}
+
+bool cpu_has_avx2()
+{
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+#else
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+    return false;
+  __cpuid(info, 1);
+  /* the os must save the ymm registers on context switches */
+  if (!(info[2] & (1 << 27)) || (_xgetbv(0) & 0x6) != 0x6)
+    return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#endif
+}
+#endif
+
+#if DDSCXX_SWAP_NEON
+template<typename U>
+void swap_copy_neon(unsigned char *dst, const unsigned char *src, size_t N)
+{
+  const size_t per_vec = sizeof(uint8x16_t)/sizeof(U);
+  for (; N >= per_vec; N -= per_vec, dst += sizeof(uint8x16_t), src += sizeof(uint8x16_t)) {
+    uint8x16_t v = vld1q_u8(src);
+    switch (sizeof(U)) {
+      case 2:
+        v = vrev16q_u8(v);
+        break;
+      case 4:
+        v = vrev32q_u8(v);
+        break;
+      default:
+        v = vrev64q_u8(v);
+    }
+    vst1q_u8(dst, v);
+  }
+  swap_copy_scalar<U>(dst, src, N);
+}
+#endif
+
+struct swap_copy_kernels {
+  swap_copy_fn swap_2, swap_4, swap_8;
+};
+
+swap_copy_kernels select_kernels()
+{
+#if DDSCXX_SWAP_AVX2
+  if (cpu_has_avx2())
+    return {swap_copy_avx2<uint16_t>, swap_copy_avx2<uint32_t>, swap_copy_avx2<uint64_t>};
+#endif
+#if DDSCXX_SWAP_SSE2
+  return {swap_copy_sse2<uint16_t>, swap_copy_sse2<uint32_t>, swap_copy_sse2<uint64_t>};
+#elif DDSCXX_SWAP_NEON
+  return {swap_copy_neon<uint16_t>, swap_copy_neon<uint32_t>, swap_copy_neon<uint64_t>};
+#else
+  return {swap_copy_scalar<uint16_t>, swap_copy_scalar<uint32_t>, swap_copy_scalar<uint64_t>};
+#endif
+}
+
+}
+
+void byte_swap_copy(void *dst, const void *src, size_t N, size_t size) noexcept
+{
+  static const swap_copy_kernels kernels = select_kernels();
+
+  auto to = static_cast<unsigned char*>(dst);
+  auto from = static_cast<const unsigned char*>(src);
+  switch (size) {
+    case 2:
+      kernels.swap_2(to, from, N);
+      break;
+    case 4:
+      kernels.swap_4(to, from, N);
+      break;
+    case 8:
+      kernels.swap_8(to, from, N);
+      break;
+    default:
+      assert(size == 1);
+      memcpy(to, from, N*size);
+  }
+}
+
+}
+}
+}
+}
+}  /* namespace org / eclipse / cyclonedds / core / cdr */
@@ -120,7 +120,7 @@ bool cdr_stream::check_struct_completeness(const entity_properties_t &props, con
   const entity_properties_t *ptr = props.first_member;
   while (ptr) {
     if ((ptr->must_understand || ptr->is_key) &&  //if this entity is a must_understand or key member
-        member_ids.end() == member_ids.find(ptr->m_id) && //and it was not succesfully deserialized
+        !member_ids.contains(ptr->member_index) && //and it was not succesfully deserialized
         status(must_understand_fail)) //and we cannot ignore missing must_understand fields
       return false;
     ptr = cdr_stream::next_entity(ptr);
@@ -132,7 +132,7 @@ bool cdr_stream::check_struct_completeness(const entity_properties_t &props, con
 bool cdr_stream::finish_member(const entity_properties_t &props, member_id_set &member_ids, bool is_set)
 {
   if (is_set)
-    member_ids.insert(props.m_id);
+    member_ids.insert(props.member_index);
   return true;
 }
 
@@ -127,6 +127,23 @@ void entity_properties_t::finish(propvec &props, const key_endpoint &keys)
 
     if (ptr->parent)
       ptr->p_ext = ptr->parent->e_ext;
+
+    if (ptr->prev_on_level)
+      ptr->member_index = ptr->prev_on_level->member_index + 1;
+  }
+
+  //index the members of mutable entities by member id
+  for (auto &prop:props) {
+    prop.members_by_id.clear();
+    if (prop.e_ext != extensibility::ext_mutable)
+      continue;
+
+    for (auto member = prop.first_member; member; member = member->next_on_level)
+      prop.members_by_id.emplace_back(member->m_id, member);
+    std::sort(prop.members_by_id.begin(), prop.members_by_id.end(),
+      [](const std::pair<uint32_t, const entity_properties_t*> &lhs, const std::pair<uint32_t, const entity_properties_t*> &rhs) {
+        return lhs.first < rhs.first;
+      });
   }
 
   auto &root = props[0];
@@ -200,6 +217,26 @@ const entity_properties_t* entity_properties_t::previous_entity(key_mode key) co
   }
 }
 
+const entity_properties_t* entity_properties_t::find_member(uint32_t member_id, key_mode key) const
+{
+  const entity_properties_t *ptr = nullptr;
+  if (member_id < members_by_id.size() && members_by_id[member_id].first == member_id) {
+    ptr = members_by_id[member_id].second;
+  } else {
+    auto it = std::lower_bound(members_by_id.begin(), members_by_id.end(), member_id,
+      [](const std::pair<uint32_t, const entity_properties_t*> &lhs, uint32_t rhs) {
+        return lhs.first < rhs;
+      });
+    if (it != members_by_id.end() && it->first == member_id)
+      ptr = it->second;
+  }
+
+  if (ptr && key != key_mode::not_key && !ptr->is_key)
+    return nullptr;
+
+  return ptr;
+}
+
 void entity_properties_t::print() const
 {
   std::cout <<  std::string( 2*depth, ' ' ) << "id: " << m_id << std::endl;
@@ -260,6 +297,7 @@ void entity_properties_t::append_struct_contents(propvec &appendto, const propve
     appendto[i].next_sorted_key     = nullptr;
     appendto[i].prev_unsorted_key   = nullptr;
     appendto[i].prev_sorted_key     = nullptr;
+    appendto[i].members_by_id.clear();
   }
 }
 
@@ -20,6 +20,8 @@
 #include <org/eclipse/cyclonedds/topic/BuiltinTopicCopy.hpp>
 #include <dds/dds.h>
 
+#include <vector>
+
 #include "dds/ddsi/ddsi_protocol.h"
 #include "dds/features.hpp"
 
@@ -38,7 +40,7 @@ namespace pub
 AnyDataWriterDelegate::AnyDataWriterDelegate(
         const dds::pub::qos::DataWriterQos& qos,
         const dds::topic::TopicDescription& td)
-    : qos_(qos), td_(td)
+    : qos_(qos), td_(td), ser_type_(nullptr)
 {
 }
 
@@ -46,9 +48,34 @@ AnyDataWriterDelegate::~AnyDataWriterDelegate()
 {
 }
 
+void
+AnyDataWriterDelegate::publication_queue(const std::shared_ptr<PublicationQueue>& queue)
+{
+    this->queue_ = queue;
+}
+
+void
+AnyDataWriterDelegate::set_ser_type(dds_entity_t writer)
+{
+    /* The sertype is owned by the writer, so it remains valid for as long as the writer exists. */
+    const struct ddsi_sertype *ser_type = nullptr;
+    dds_return_t ret = dds_get_entity_sertype(writer, &ser_type);
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not get the sertype of the DataWriter.");
+    this->ser_type_ = ser_type;
+}
+
+const struct ddsi_sertype *
+AnyDataWriterDelegate::get_ser_type() const
+{
+    return this->ser_type_;
+}
+
 void
 AnyDataWriterDelegate::close()
 {
+    /* Updates of the writer that are still queued by its suspended publisher are discarded. */
+    if (this->queue_)
+        this->queue_->discard(ddsc_entity);
     this->td_ = dds::topic::TopicDescription(dds::core::null);
     org::eclipse::cyclonedds::core::EntityDelegate::close();
 }
@@ -90,11 +117,10 @@ AnyDataWriterDelegate::write_cdr(
     const dds::core::Time& timestamp,
     uint32_t statusinfo)
 {
-    dds_return_t ret;
     struct ddsi_serdata *ser_data;
     ddsrt_iovec_t blob_holders[2];
 
-    /* Ignore the handle until ddsc supports writes with instance handles. */
+    /* The key of the instance is taken from the CDR payload, which needs to contain it anyway. */
     (void)handle;
 
     /* Create an array of ddsrt_iovec_t to contain both the encoding and the CDR payload. */
@@ -110,18 +136,85 @@ AnyDataWriterDelegate::write_cdr(
         2,
         blob_holders,
         data->payload().size() + 4);
+    if (ser_data == nullptr)
+        ISOCPP_THROW_EXCEPTION(ISOCPP_ERROR, "write_cdr failed: could not create serdata.");
 
-    ser_data->statusinfo = statusinfo;
+    this->write_serdata(writer, ser_data, timestamp, statusinfo, "write_cdr failed.");
+}
 
-    if (timestamp != dds::core::Time::invalid()) {
-        dds_time_t ddsc_time = org::eclipse::cyclonedds::core::convertTime(timestamp);
-        ser_data->timestamp.v = ddsc_time;
-        ret = dds_forwardcdr(writer, ser_data);
-    } else {
-        ret = dds_writecdr(writer, ser_data);
-    }
+void
+AnyDataWriterDelegate::write_serdata(
+    dds_entity_t writer,
+    struct ddsi_serdata *data,
+    const dds::core::Time& timestamp,
+    uint32_t statusinfo,
+    const char *error)
+{
+    dds_return_t ret;
+
+    data->statusinfo = statusinfo;
+
+    /* While the publisher is suspended, the update is queued by the publisher. */
+    if (this->queue_ && this->queue_->enqueue(writer, data, timestamp))
+        return;
+
+    /* dds_writecdr would reset the statusinfo, so the serdata is forwarded with the current
+       time instead. ddsc takes over the reference to the serdata, also when writing it fails. */
+    if (timestamp != dds::core::Time::invalid())
+        data->timestamp.v = org::eclipse::cyclonedds::core::convertTime(timestamp);
+    else
+        data->timestamp.v = dds_time();
+    ret = dds_forwardcdr(writer, data);
+
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, error);
+}
+
+bool
+AnyDataWriterDelegate::write_queued(
+    dds_entity_t writer,
+    const void *data,
+    const dds::core::Time& timestamp,
+    uint32_t statusinfo,
+    const char *error)
+{
+    if (!this->queue_ || !this->queue_->queueing())
+        return false;
+
+    /* Samples are serialized when they are written, only their transmission is postponed. */
+    struct ddsi_serdata *ser_data = ddsi_serdata_from_sample(this->get_ser_type(), SDK_DATA, data);
+    if (ser_data == nullptr)
+        ISOCPP_THROW_EXCEPTION(ISOCPP_ERROR, "Could not serialize sample.");
+
+    this->write_serdata(writer, ser_data, timestamp, statusinfo, error);
+    return true;
+}
+
+void
+AnyDataWriterDelegate::flush_queued()
+{
+    /* Instances are disposed and unregistered by ddsc directly, so the updates queued before
+       are written first to keep them in order. Those updates may be of any writer of the
+       publisher, so errors writing them are left for the publisher to report. */
+    if (this->queue_ && this->queue_->queueing())
+        this->queue_->flush(false);
+}
+
+void
+AnyDataWriterDelegate::write_serdata(
+    dds_entity_t writer,
+    struct ddsi_serdata *data,
+    const dds::core::Time& timestamp)
+{
+    this->write_serdata(writer, data, timestamp, 0, "write failed.");
+}
 
-    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "write_cdr failed.");
+void
+AnyDataWriterDelegate::writedispose_serdata(
+    dds_entity_t writer,
+    struct ddsi_serdata *data,
+    const dds::core::Time& timestamp)
+{
+    this->write_serdata(writer, data, timestamp, DDSI_STATUSINFO_DISPOSE, "writedispose failed.");
 }
 
 void
@@ -193,9 +286,13 @@ AnyDataWriterDelegate::write(
 {
     dds_return_t ret;
 
-    /* Ignore the handle until ddsc supports writes with instance handles. */
+    /* ddsc cannot write by instance handle, writes of registered instances of which the key is
+       known are done through write_serdata instead. */
     (void)handle;
 
+    if (this->write_queued(writer, data, timestamp, 0, "write failed."))
+        return;
+
     if (timestamp != dds::core::Time::invalid()) {
         dds_time_t ddsc_time = org::eclipse::cyclonedds::core::convertTime(timestamp);
         ret = dds_write_ts(writer, data, ddsc_time);
@@ -206,6 +303,53 @@ AnyDataWriterDelegate::write(
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "write failed.");
 }
 
+void
+AnyDataWriterDelegate::write_batch(
+    dds_entity_t writer,
+    struct ddsi_serdata * const *batch,
+    size_t n,
+    const dds::core::Time& timestamp)
+{
+    dds_return_t ret = DDS_RETCODE_OK;
+
+    /* The serdata of the batch are serialized by DataWriter<T> before any of them is handed to
+       ddsc, which takes over the reference to each of them. */
+
+    /* While the publisher is suspended, the batch is queued along with the updates of the
+       other writers of the publisher. */
+    size_t i = 0;
+    if (this->queue_) {
+        try {
+            while (i < n && this->queue_->enqueue(writer, batch[i], timestamp))
+                i++;
+        } catch (...) {
+            /* Only queueing itself can fail, before the queue took over the serdata. */
+            for (; i < n; i++)
+                ddsi_serdata_unref(batch[i]);
+            throw;
+        }
+        if (i == n)
+            return;
+    }
+
+    /* ddsc consumes the reference to each serdata, also when writing it fails, so only the
+       serdata that were not handed over yet need to be released after a failure. */
+    dds_time_t ddsc_time = (timestamp != dds::core::Time::invalid()) ?
+        org::eclipse::cyclonedds::core::convertTime(timestamp) : dds_time();
+    for (; i < n && ret == DDS_RETCODE_OK; i++) {
+        batch[i]->timestamp.v = ddsc_time;
+        ret = dds_forwardcdr(writer, batch[i]);
+    }
+    for (; i < n; i++)
+        ddsi_serdata_unref(batch[i]);
+
+    /* The end of the batch is its flush point, for writers that batch updates. */
+    if (ret == DDS_RETCODE_OK)
+        ret = dds_write_flush(writer);
+
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "write failed.");
+}
+
 void
 AnyDataWriterDelegate::writedispose(
     dds_entity_t writer,
@@ -215,9 +359,13 @@ AnyDataWriterDelegate::writedispose(
 {
     dds_return_t ret;
 
-    /* Ignore the handle until ddsc supports writes with instance handles. */
+    /* ddsc cannot write by instance handle, writes of registered instances of which the key is
+       known are done through writedispose_serdata instead. */
     (void)handle;
 
+    if (this->write_queued(writer, data, timestamp, DDSI_STATUSINFO_DISPOSE, "writedispose failed."))
+        return;
+
     if (timestamp != dds::core::Time::invalid()) {
         dds_time_t ddsc_time = org::eclipse::cyclonedds::core::convertTime(timestamp);
         ret = dds_writedispose_ts(writer, data, ddsc_time);
@@ -262,6 +410,8 @@ AnyDataWriterDelegate::unregister_instance(
     }
     ih = handle.delegate().handle();
 
+    this->flush_queued();
+
     if (timestamp != dds::core::Time::invalid()) {
         dds_time_t ddsc_time = org::eclipse::cyclonedds::core::convertTime(timestamp);
         ret = dds_unregister_instance_ih_ts(writer, ih, ddsc_time);
@@ -285,6 +435,8 @@ AnyDataWriterDelegate::unregister_instance(
                                "data is null");
     }
 
+    this->flush_queued();
+
     if (timestamp != dds::core::Time::invalid()) {
         dds_time_t ddsc_time = org::eclipse::cyclonedds::core::convertTime(timestamp);
         ret = dds_unregister_instance_ts(writer, data, ddsc_time);
@@ -310,6 +462,8 @@ AnyDataWriterDelegate::dispose_instance(
     }
     ih = handle.delegate().handle();
 
+    this->flush_queued();
+
     if (timestamp != dds::core::Time::invalid()) {
         dds_time_t ddsc_time = org::eclipse::cyclonedds::core::convertTime(timestamp);
         ret = dds_dispose_ih_ts(writer, ih, ddsc_time);
@@ -333,6 +487,8 @@ AnyDataWriterDelegate::dispose_instance(
                                "data is null");
     }
 
+    this->flush_queued();
+
     if (timestamp != dds::core::Time::invalid()) {
         dds_time_t ddsc_time = org::eclipse::cyclonedds::core::convertTime(timestamp);
         ret = dds_dispose_ts(writer, data, ddsc_time);
@@ -465,8 +621,18 @@ void
 AnyDataWriterDelegate::wait_for_acknowledgments(
     const dds::core::Duration& timeout)
 {
-   ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
-   (void)timeout;
+    this->check();
+
+    /* Samples that are still queued for an asynchronous write have not reached ddsc yet. */
+    this->wait_for_async_writes();
+
+    dds_return_t ret = dds_wait_for_acks(ddsc_entity, org::eclipse::cyclonedds::core::convertDuration(timeout));
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "wait_for_acknowledgments failed.");
+}
+
+void
+AnyDataWriterDelegate::wait_for_async_writes()
+{
 }
 
 dds::pub::TAnyDataWriter<AnyDataWriterDelegate>
@@ -481,6 +647,7 @@ AnyDataWriterDelegate::wrapper_to_any()
 void
 AnyDataWriterDelegate::write_flush()
 {
+    this->wait_for_async_writes();
     dds_write_flush (ddsc_entity);
 }
 
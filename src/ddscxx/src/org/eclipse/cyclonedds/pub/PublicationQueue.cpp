@@ -0,0 +1,251 @@
+// Copyright(c) 2024 ZettaScale Technology and others
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+// v. 1.0 which is available at
+// http://www.eclipse.org/org/documents/edl-v10.php.
+//
+// SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+
+/**
+ * @file
+ */
+
+#include <org/eclipse/cyclonedds/pub/PublicationQueue.hpp>
+#include <org/eclipse/cyclonedds/core/ReportUtils.hpp>
+#include <org/eclipse/cyclonedds/core/MiscUtils.hpp>
+
+#include <algorithm>
+
+#include "dds/ddsi/ddsi_serdata.h"
+
+
+namespace org
+{
+namespace eclipse
+{
+namespace cyclonedds
+{
+namespace pub
+{
+
+PublicationQueue::PublicationQueue()
+    : suspended_(false), flushing_(false), depth_(0), bytes_(0), error_(DDS_RETCODE_OK), max_samples_(0), max_bytes_(0),
+      max_delay_(DDS_INFINITY), stop_(false)
+{
+}
+
+PublicationQueue::~PublicationQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cond_.notify_all();
+    if (timer_.joinable())
+        timer_.join();
+
+    /* Updates still queued when the publisher is deleted are discarded. */
+    this->discard();
+}
+
+void
+PublicationQueue::suspend()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    depth_++;
+    suspended_.store(true, std::memory_order_release);
+}
+
+void
+PublicationQueue::suspend(size_t max_samples, size_t max_bytes, const dds::core::Duration& max_delay)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_samples_ = max_samples;
+    max_bytes_ = max_bytes;
+    max_delay_ = org::eclipse::cyclonedds::core::convertDuration(max_delay);
+    depth_++;
+    suspended_.store(true, std::memory_order_release);
+
+    /* The timer only exists for queues that were given a time limit at some point. */
+    if (max_delay_ != DDS_INFINITY && !timer_.joinable())
+        timer_ = std::thread(&PublicationQueue::flush_on_timeout, this);
+    cond_.notify_all();
+}
+
+void
+PublicationQueue::resume()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (depth_ == 0)
+        ISOCPP_THROW_EXCEPTION(ISOCPP_PRECONDITION_NOT_MET_ERROR, "Publications are not suspended.");
+    if (--depth_ > 0)
+        return;
+
+    max_samples_ = 0;
+    max_bytes_ = 0;
+    max_delay_ = DDS_INFINITY;
+    this->report_error(lock, this->flush_updates(lock, true));
+}
+
+bool
+PublicationQueue::enqueue(dds_entity_t writer, struct ddsi_serdata *data, const dds::core::Time& timestamp)
+{
+    /* Writes of publishers that are neither suspended nor writing queued updates do not take the
+       lock. A flush is announced before the queue is resumed, so a write that sees the queue
+       resumed also sees the flush, and is queued behind the updates that are being written. */
+    if (!suspended_.load(std::memory_order_seq_cst) && !flushing_.load(std::memory_order_seq_cst))
+        return false;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!suspended_.load(std::memory_order_relaxed) && !flushing_.load(std::memory_order_relaxed))
+        return false;
+
+    /* The source timestamp is that of the write, not that of the flush. */
+    if (timestamp != dds::core::Time::invalid())
+        data->timestamp.v = org::eclipse::cyclonedds::core::convertTime(timestamp);
+    else
+        data->timestamp.v = dds_time();
+
+    if (updates_.empty()) {
+        oldest_ = std::chrono::steady_clock::now();
+        cond_.notify_all();
+    }
+    update u = { writer, data };
+    updates_.push_back(u);
+    bytes_ += ddsi_serdata_size(data);
+
+    /* While resumed, the update is written by the thread that writes the queued updates. */
+    if (suspended_.load(std::memory_order_relaxed) &&
+        ((max_samples_ > 0 && updates_.size() >= max_samples_) ||
+         (max_bytes_ > 0 && bytes_ >= max_bytes_)))
+        this->keep_error(this->flush_updates(lock, false));
+    return true;
+}
+
+void
+PublicationQueue::flush(bool report)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    dds_return_t ret = this->flush_updates(lock, false);
+    if (report)
+        this->report_error(lock, ret);
+    else
+        this->keep_error(ret);
+}
+
+void
+PublicationQueue::keep_error(dds_return_t ret)
+{
+    if (ret != DDS_RETCODE_OK && error_ == DDS_RETCODE_OK)
+        error_ = ret;
+}
+
+void
+PublicationQueue::report_error(std::unique_lock<std::mutex>& lock, dds_return_t ret)
+{
+    /* An error of an earlier automatic flush is reported first, it happened first. */
+    if (error_ != DDS_RETCODE_OK)
+        ret = error_;
+    error_ = DDS_RETCODE_OK;
+    lock.unlock();
+
+    ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Could not write suspended publications.");
+}
+
+dds_return_t
+PublicationQueue::flush_updates(std::unique_lock<std::mutex>& lock, bool resume)
+{
+    /* Listeners invoked by the writes of a flush run on the flushing thread, the updates they
+       write are queued behind the ones being written, and written by the same flush. */
+    const std::thread::id self = std::this_thread::get_id();
+    if (flusher_ == self) {
+        if (resume)
+            suspended_.store(false, std::memory_order_seq_cst);
+        return DDS_RETCODE_OK;
+    }
+
+    /* One thread at a time writes the queued updates, so that they are written in order. */
+    cond_.wait(lock, [this]() { return !flushing_.load(std::memory_order_relaxed); });
+    flushing_.store(true, std::memory_order_seq_cst);
+    flusher_ = self;
+    if (resume)
+        suspended_.store(false, std::memory_order_seq_cst);
+
+    /* The updates are written without the lock, which may block on flow control. Updates queued
+       meanwhile are written as well once the queue is resumed, otherwise they remain queued.
+       ddsc takes over the reference to each serdata, also when writing it fails, so the first
+       error is returned after all of them were handed over. */
+    dds_return_t ret = DDS_RETCODE_OK;
+    std::vector<update> updates;
+    std::vector<dds_entity_t> writers;
+    while (!updates_.empty()) {
+        updates.clear();
+        updates.swap(updates_);
+        bytes_ = 0;
+        lock.unlock();
+
+        writers.clear();
+        for (const update& u:updates) {
+            dds_return_t r = dds_forwardcdr(u.writer, u.data);
+            if (r != DDS_RETCODE_OK && ret == DDS_RETCODE_OK)
+                ret = r;
+            if (std::find(writers.begin(), writers.end(), u.writer) == writers.end())
+                writers.push_back(u.writer);
+        }
+        for (dds_entity_t w:writers)
+            (void)dds_write_flush(w);
+
+        lock.lock();
+        if (suspended_.load(std::memory_order_relaxed))
+            break;
+    }
+
+    flushing_.store(false, std::memory_order_seq_cst);
+    flusher_ = std::thread::id();
+    cond_.notify_all();
+    return ret;
+}
+
+void
+PublicationQueue::discard(dds_entity_t writer)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<update> kept;
+    bytes_ = 0;
+    for (const update& u:updates_) {
+        if (writer == 0 || u.writer == writer) {
+            ddsi_serdata_unref(u.data);
+        } else {
+            kept.push_back(u);
+            bytes_ += ddsi_serdata_size(u.data);
+        }
+    }
+    updates_.swap(kept);
+}
+
+void
+PublicationQueue::flush_on_timeout()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+        if (updates_.empty() || max_delay_ == DDS_INFINITY) {
+            cond_.wait(lock);
+            continue;
+        }
+
+        const auto deadline = oldest_ + std::chrono::nanoseconds(max_delay_);
+        if (std::chrono::steady_clock::now() < deadline) {
+            cond_.wait_until(lock, deadline);
+            continue;
+        }
+
+        this->keep_error(this->flush_updates(lock, false));
+    }
+}
+
+}
+}
+}
+}
@@ -39,7 +39,8 @@ PublisherDelegate::PublisherDelegate(const dds::domain::DomainParticipant& dp,
                                      const dds::core::status::StatusMask& event_mask)
     :   dp_(dp),
         qos_(qos),
-        default_dwqos_()
+        default_dwqos_(),
+        queue_(std::make_shared<PublicationQueue>())
 {
     dds_entity_t ddsc_par;
     dds_entity_t ddsc_pub;
@@ -95,6 +96,9 @@ PublisherDelegate::close()
 {
     org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
 
+    /* Suspended updates that were not published yet are discarded. */
+    this->queue_->discard();
+
     /* Close the datawriters. */
     this->writers.all_close();
 
@@ -153,13 +157,35 @@ PublisherDelegate::default_datawriter_qos(const dds::pub::qos::DataWriterQos& dw
 void
 PublisherDelegate::suspend_publications()
 {
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+    this->check();
+    this->queue_->suspend();
+}
+
+void
+PublisherDelegate::suspend_publications(size_t max_samples,
+                                        size_t max_bytes,
+                                        const dds::core::Duration& max_delay)
+{
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+    this->check();
+    this->queue_->suspend(max_samples, max_bytes, max_delay);
 }
 
 void
 PublisherDelegate::resume_publications()
 {
-    ISOCPP_THROW_EXCEPTION(ISOCPP_UNSUPPORTED_ERROR, "Function not currently supported");
+    org::eclipse::cyclonedds::core::ScopedObjectLock scopedLock(*this);
+    this->check();
+    /* Writing the queued updates can trigger listeners, which may use the publisher. */
+    scopedLock.unlock();
+    this->queue_->resume();
+}
+
+const std::shared_ptr<PublicationQueue>&
+PublisherDelegate::publication_queue() const
+{
+    return this->queue_;
 }
 
 void
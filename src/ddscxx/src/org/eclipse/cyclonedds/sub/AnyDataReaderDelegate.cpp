@@ -144,6 +144,18 @@ AnyDataReaderDelegate::collector_callback_fn (
     return DDS_RETCODE_OK;
 }
 
+dds_return_t
+AnyDataReaderDelegate::take_collector_callback_fn (
+    void *arg,
+    const dds_sample_info_t *si,
+    const struct ddsi_sertype *,
+    struct ddsi_serdata *sd)
+{
+    dds::sub::detail::SamplesHolder *sh = reinterpret_cast<dds::sub::detail::SamplesHolder *>(arg);
+    sh->take_sample(sd, si);
+    return DDS_RETCODE_OK;
+}
+
 
 bool
 AnyDataReaderDelegate::is_loan_supported(const dds_entity_t reader) const
@@ -195,7 +207,7 @@ AnyDataReaderDelegate::take_cdr(
                                   NORMALIZE_LENGTH(requested_max_samples),
                                   DDS_HANDLE_NIL,
                                   ddsc_mask,
-                                  collector_callback_fn,
+                                  take_collector_callback_fn,
                                   &samples);
 
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Getting sample failed.");
@@ -244,7 +256,7 @@ AnyDataReaderDelegate::loaned_take(
                                   NORMALIZE_LENGTH(requested_max_samples),
                                   DDS_HANDLE_NIL,
                                   ddsc_mask,
-                                  collector_callback_fn,
+                                  take_collector_callback_fn,
                                   &samples);
 
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Getting sample failed.");
@@ -294,7 +306,7 @@ AnyDataReaderDelegate::loaned_take_instance(
                                   NORMALIZE_LENGTH(requested_max_samples),
                                   handle->handle(),
                                   ddsc_mask,
-                                  collector_callback_fn,
+                                  take_collector_callback_fn,
                                   &samples);
 
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Getting sample failed.");
@@ -368,7 +380,7 @@ AnyDataReaderDelegate::take(
     this->check();
 
     /* The reader can also be a condition. */
-    ret = dds_take_with_collector(reader, NORMALIZE_LENGTH(requested_max_samples), DDS_HANDLE_NIL, ddsc_mask, collector_callback_fn, &samples);
+    ret = dds_take_with_collector(reader, NORMALIZE_LENGTH(requested_max_samples), DDS_HANDLE_NIL, ddsc_mask, take_collector_callback_fn, &samples);
 
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Getting sample failed.");
 }
@@ -408,7 +420,7 @@ AnyDataReaderDelegate::take_instance(
     this->check();
 
     /* The reader can also be a condition. */
-    ret = dds_take_with_collector(reader, NORMALIZE_LENGTH(requested_max_samples), handle->handle(), ddsc_mask, collector_callback_fn, &samples);
+    ret = dds_take_with_collector(reader, NORMALIZE_LENGTH(requested_max_samples), handle->handle(), ddsc_mask, take_collector_callback_fn, &samples);
 
     ISOCPP_DDSC_RESULT_CHECK_AND_THROW(ret, "Getting sample failed.");
 }
@@ -28,14 +28,59 @@ namespace org
         }
 
         bool complex_key(const std::vector<unsigned char>& in, ddsi_keyhash_t& out)
+        {
+          return complex_key(in.data(), in.size(), out);
+        }
+
+        bool complex_key(const unsigned char* in, size_t sz, ddsi_keyhash_t& out)
         {
           ddsrt_md5_state_t md5st;
           ddsrt_md5_init(&md5st);
-          ddsrt_md5_append(&md5st, reinterpret_cast<const ddsrt_md5_byte_t*>(in.data()), static_cast<unsigned int>(in.size()));
+          ddsrt_md5_append(&md5st, reinterpret_cast<const ddsrt_md5_byte_t*>(in), static_cast<unsigned int>(sz));
           ddsrt_md5_finish(&md5st, reinterpret_cast<ddsrt_md5_byte_t*>(out.value));
 
           return true;
         }
+
+        static inline uint64_t mix(uint64_t k)
+        {
+          k ^= k >> 33;
+          k *= 0xff51afd7ed558ccdULL;
+          k ^= k >> 33;
+          k *= 0xc4ceb9fe1a85ec53ULL;
+          k ^= k >> 33;
+          return k;
+        }
+
+        uint32_t key_hash(const ddsi_keyhash_t& key)
+        {
+          uint64_t lo, hi;
+          memcpy(&lo, key.value, sizeof(lo));
+          memcpy(&hi, key.value + sizeof(lo), sizeof(hi));
+
+          uint64_t h = mix(lo ^ mix(hi + 0x9e3779b97f4a7c15ULL));
+          return static_cast<uint32_t>(h ^ (h >> 32));
+        }
+
+        uint32_t type_hash(const char* type_name, const unsigned char* type_info, size_t type_info_sz, uint16_t encoding)
+        {
+          /* the name and the type information identify the type, the encoding distinguishes the
+             sertypes of the different data representations of the type */
+          ddsrt_md5_state_t md5st;
+          ddsrt_md5_byte_t digest[16];
+          ddsrt_md5_init(&md5st);
+          ddsrt_md5_append(&md5st, reinterpret_cast<const ddsrt_md5_byte_t*>(type_name), static_cast<unsigned int>(strlen(type_name)));
+          if (type_info && type_info_sz > 0)
+            ddsrt_md5_append(&md5st, reinterpret_cast<const ddsrt_md5_byte_t*>(type_info), static_cast<unsigned int>(type_info_sz));
+          ddsrt_md5_finish(&md5st, digest);
+
+          uint64_t lo, hi;
+          memcpy(&lo, digest, sizeof(lo));
+          memcpy(&hi, digest + sizeof(lo), sizeof(hi));
+
+          uint64_t h = mix(lo ^ mix(hi + encoding));
+          return static_cast<uint32_t>(h ^ (h >> 32));
+        }
       }
     }
   }
@@ -190,6 +190,48 @@ TEST_F(CDRStreamer, cdr_mutable)
 
   VerifyRead(MS_xcdr_v1_normal_reordered, MS, xcdr_v1_stream, key_mode::not_key, true, true);
   VerifyRead(MS_xcdr_v2_normal_reordered, MS, xcdr_v2_stream, key_mode::not_key, true, true);
+
+  /*the key members are picked out of the out of order members, the others are skipped*/
+  VerifyRead(MS_xcdr_v1_normal_reordered, MS, xcdr_v1_stream, key_mode::unsorted, true, true);
+  VerifyRead(MS_xcdr_v2_normal_reordered, MS, xcdr_v2_stream, key_mode::unsorted, true, true);
+}
+
+/*verifying the lookup of the members of mutable types by member id*/
+
+TEST_F(CDRStreamer, cdr_mutable_find_member)
+{
+  const auto &props = get_type_props<mutablestruct>();
+  const entity_properties_t &ms = props[0];
+
+  /*the member ids are not consecutive from 0, and are declared in descending order*/
+  ASSERT_EQ(ms.members_by_id.size(), 4u);
+  for (uint32_t id:{1u, 3u, 5u, 7u}) {
+    const entity_properties_t *member = ms.find_member(id, key_mode::not_key);
+    ASSERT_NE(member, nullptr);
+    EXPECT_EQ(member->m_id, id);
+  }
+  EXPECT_EQ(ms.find_member(0, key_mode::not_key), nullptr);
+  EXPECT_EQ(ms.find_member(4, key_mode::not_key), nullptr);
+  EXPECT_EQ(ms.find_member(8, key_mode::not_key), nullptr);
+
+  /*in key mode only the key members are found*/
+  const entity_properties_t *key = ms.find_member(5, key_mode::unsorted);
+  ASSERT_NE(key, nullptr);
+  EXPECT_TRUE(key->is_key);
+  for (uint32_t id:{1u, 3u, 7u})
+    EXPECT_EQ(ms.find_member(id, key_mode::unsorted), nullptr);
+
+  /*consecutive member ids from 0 are looked up directly*/
+  const auto &oms_props = get_type_props<optional_mutable_struct>();
+  const entity_properties_t &oms = oms_props[0];
+  for (uint32_t id = 0; id < 3; id++) {
+    const entity_properties_t *member = oms.find_member(id, key_mode::not_key);
+    ASSERT_NE(member, nullptr);
+    EXPECT_EQ(member->m_id, id);
+  }
+  EXPECT_EQ(oms.find_member(3, key_mode::not_key), nullptr);
+  ASSERT_NE(oms.find_member(2, key_mode::sorted), nullptr);
+  EXPECT_EQ(oms.find_member(0, key_mode::sorted), nullptr);
 }
 
 /*verifying reads/writes of a nested struct*/
@@ -639,6 +681,74 @@ TEST_F(CDRStreamer, cdr_enum)
   readwrite_test(ES, ES, ES_xcdr_v1_normal, ES_xcdr_v1_key, xcdr_v2_stream);
 }
 
+/*verifying the streamer will correctly read and write sequences of enums and booleans*/
+
+TEST_F(CDRStreamer, cdr_enum_bool_sequence)
+{
+  enum_bool_sequences EBS(1, {enum_32::second_32, enum_32::fourth_32}, {true, false, true});
+
+  bytes EBS_xcdr_v1_normal {
+      0x00, 0x00, 0x00, 0x01 /*enum_bool_sequences.c*/,
+      0x00, 0x00, 0x00, 0x02 /*enum_bool_sequences.e.length*/,
+      0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x03 /*enum_bool_sequences.e.data*/,
+      0x00, 0x00, 0x00, 0x03 /*enum_bool_sequences.b.length*/,
+      0x01, 0x00, 0x01 /*enum_bool_sequences.b.data*/
+      };
+  bytes EBS_xcdr_v2_normal {
+      0x00, 0x00, 0x00, 0x01 /*enum_bool_sequences.c*/,
+      0x00, 0x00, 0x00, 0x0C /*enum_bool_sequences.e.d_header*/,
+      0x00, 0x00, 0x00, 0x02 /*enum_bool_sequences.e.length*/,
+      0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x03 /*enum_bool_sequences.e.data*/,
+      0x00, 0x00, 0x00, 0x03 /*enum_bool_sequences.b.length*/,
+      0x01, 0x00, 0x01 /*enum_bool_sequences.b.data*/
+      };
+  bytes EBS_key {
+      0x00, 0x00, 0x00, 0x01 /*enum_bool_sequences.c*/
+      };
+
+  readwrite_test(EBS, EBS, EBS_xcdr_v1_normal, EBS_key, xcdr_v1_stream);
+  readwrite_test(EBS, EBS, EBS_xcdr_v2_normal, EBS_key, xcdr_v2_stream);
+
+  /*enum values without an enumerator are read as the default enumerator*/
+  enum_bool_sequences EBS_default(1, {enum_32::second_32, enum_32::first_32}, {true, false, true});
+  bytes EBS_invalid_enum(EBS_xcdr_v1_normal);
+  EBS_invalid_enum[15] = 0x07;
+  VerifyRead(EBS_invalid_enum, EBS_default, xcdr_v1_stream, key_mode::not_key, true, true);
+
+  /*booleans which are not 0 or 1 are rejected*/
+  bytes EBS_invalid_bool(EBS_xcdr_v1_normal);
+  EBS_invalid_bool[21] = 0x02;
+  VerifyRead(EBS_invalid_bool, EBS, xcdr_v1_stream, key_mode::not_key, false, false);
+
+  /*the same goes for single booleans*/
+  bytes bools {0x01, 0x00, 0x02};
+  xcdr_v1_stream bool_str(endianness::big_endian);
+  bool_str.set_buffer(bools.data(), bools.size());
+  bool b = false;
+  ASSERT_TRUE(read(bool_str, b));
+  EXPECT_TRUE(b);
+  ASSERT_TRUE(read(bool_str, b));
+  EXPECT_FALSE(b);
+  EXPECT_FALSE(read(bool_str, b));
+
+  /*sequences spanning multiple blocks*/
+  enum_bool_sequences EBS_long;
+  EBS_long.c(1);
+  bytes EBS_long_normal {0x00, 0x00, 0x00, 0x01 /*enum_bool_sequences.c*/,
+                         0x00, 0x00, 0x00, 150 /*enum_bool_sequences.e.length*/};
+  for (unsigned char i = 0; i < 150; i++) {
+    EBS_long.e().push_back(static_cast<enum_32>(i % 4));
+    EBS_long_normal.insert(EBS_long_normal.end(), {0x00, 0x00, 0x00, static_cast<unsigned char>(i % 4)});
+  }
+  EBS_long_normal.insert(EBS_long_normal.end(), {0x00, 0x00, 0x00, 150 /*enum_bool_sequences.b.length*/});
+  for (unsigned char i = 0; i < 150; i++) {
+    EBS_long.b().push_back(i % 3 == 0);
+    EBS_long_normal.push_back(i % 3 == 0 ? 0x01 : 0x00);
+  }
+
+  readwrite_test(EBS_long, EBS_long, EBS_long_normal, EBS_key, xcdr_v1_stream);
+}
+
 /*verifying reads/writes of structs containing optional fields*/
 
 TEST_F(CDRStreamer, cdr_optional)
@@ -914,6 +1024,30 @@ TEST_F(CDRStreamer, d_header_insertion)
 
   readwrite_test(DS, DS, DS_v1, DS_v1_key, xcdr_v1_stream);
   readwrite_test(DS, DS, DS_v2, DS_v2_key, xcdr_v2_stream);
+
+  d_hdr_arrays DA(1, {d_hdr_array_element({enum_8::fourth_8, enum_8::third_8}),
+                      d_hdr_array_element({enum_8::second_8, enum_8::first_8})});
+
+  bytes DA_v1 {
+    0x00, 0x00, 0x00, 0x01, /*d_hdr_arrays.k*/
+    0x03, 0x02, /*d_hdr_arrays.l[0].c*/
+    0x01, 0x00, /*d_hdr_arrays.l[1].c*/
+    };
+  bytes DA_v2 {
+    0x00, 0x00, 0x00, 0x01, /*d_hdr_arrays.k*/
+    0x00, 0x00, 0x00, 0x0E, /*d_hdr_arrays.l.d_header*/
+    0x00, 0x00, 0x00, 0x02, /*d_hdr_arrays.l[0].c.d_header*/
+    0x03, 0x02, /*d_hdr_arrays.l[0].c*/
+    0x00, 0x00, /*padding bytes*/
+    0x00, 0x00, 0x00, 0x02, /*d_hdr_arrays.l[1].c.d_header*/
+    0x01, 0x00, /*d_hdr_arrays.l[1].c*/
+    };
+  bytes DA_key {
+    0x00, 0x00, 0x00, 0x01, /*d_hdr_arrays.k*/
+    };
+
+  readwrite_test(DA, DA, DA_v1, DA_key, xcdr_v1_stream);
+  readwrite_test(DA, DA, DA_v2, DA_key, xcdr_v2_stream);
 }
 
 /*verifying reads/writes of structs containing bitmasks*/
@@ -950,3 +1084,57 @@ TEST_F(CDRStreamer, cdr_bitmask)
   stream_test_union(BMU, BMK, union_normal, union_key);
 
 }
+
+/*verifying the bookkeeping of (de)serialized members*/
+
+TEST_F(CDRStreamer, member_id_set)
+{
+  member_id_set_n<3> small_set;
+  small_set.insert(0);
+  small_set.insert(2);
+  EXPECT_TRUE(small_set.contains(0));
+  EXPECT_FALSE(small_set.contains(1));
+  EXPECT_TRUE(small_set.contains(2));
+  EXPECT_FALSE(small_set.contains(3));
+
+  member_id_set_n<130> large_set;
+  large_set.insert(64);
+  large_set.insert(129);
+  EXPECT_FALSE(large_set.contains(0));
+  EXPECT_FALSE(large_set.contains(63));
+  EXPECT_TRUE(large_set.contains(64));
+  EXPECT_FALSE(large_set.contains(128));
+  EXPECT_TRUE(large_set.contains(129));
+}
+
+/*verifying the swapping copy of arrays of primitives*/
+
+template<typename T>
+void swap_copy_test()
+{
+  /*covers the scalar tails of the vectorized copies and unaligned buffers*/
+  for (size_t N = 0; N < 70; N++) {
+    for (size_t offset = 0; offset < sizeof(T); offset++) {
+      std::vector<unsigned char> src(N*sizeof(T)+offset), dst(N*sizeof(T)+offset, 0x0);
+      for (size_t i = 0; i < src.size(); i++)
+        src[i] = static_cast<unsigned char>(i*7+1);
+
+      byte_swap_copy(dst.data()+offset, src.data()+offset, N, sizeof(T));
+
+      for (size_t i = 0; i < N; i++) {
+        T expected;
+        memcpy(&expected, src.data()+offset+i*sizeof(T), sizeof(T));
+        byte_swap(&expected);
+        EXPECT_EQ(0, memcmp(&expected, dst.data()+offset+i*sizeof(T), sizeof(T)));
+      }
+    }
+  }
+}
+
+TEST_F(CDRStreamer, byte_swap_copy)
+{
+  swap_copy_test<uint16_t>();
+  swap_copy_test<uint32_t>();
+  swap_copy_test<uint64_t>();
+  swap_copy_test<double>();
+}
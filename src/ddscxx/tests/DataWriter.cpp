@@ -403,6 +403,45 @@ TEST_F(DataWriter, write_InstanceHandle)
     ReadAndCheckSampleType1(testData, notReadState, true);
 }
 
+TEST_F(DataWriter, write_registered_InstanceHandle)
+{
+    Space::Type1 testInstance1(1,0,0);
+    Space::Type1 testInstance2(2,0,0);
+    Space::Type1 testData1(1,1,1);
+    Space::Type1 testData2(2,2,2);
+    Space::Type1 testData3(2,3,3);
+    dds::sub::status::DataState notReadState(
+                        dds::sub::status::SampleState::not_read(),
+                        dds::sub::status::ViewState::new_view(),
+                        dds::sub::status::InstanceState::alive());
+    dds::sub::status::DataState notReadDisposedState(
+                        dds::sub::status::SampleState::not_read(),
+                        dds::sub::status::ViewState::new_view(),
+                        dds::sub::status::InstanceState::not_alive_disposed());
+    dds::sub::status::DataState viewedDisposedState(
+                        dds::sub::status::SampleState::not_read(),
+                        dds::sub::status::ViewState::not_new_view(),
+                        dds::sub::status::InstanceState::not_alive_disposed());
+
+    /* Non-default to have history-keep-all. */
+    this->SetupCommunication(true);
+
+    /* Writes with the handles of registered instances take the key from the registration. */
+    dds::core::InstanceHandle ih1 = this->writer.register_instance(testInstance1);
+    dds::core::InstanceHandle ih2 = this->writer.register_instance(testInstance2);
+    this->writer.write(testData1, ih1);
+    this->writer.write(testData2, ih2);
+    this->writer->writedispose(testData3, ih2);
+
+    ASSERT_EQ(this->writer.lookup_instance(testData1), ih1);
+    ASSERT_EQ(this->writer.lookup_instance(testData3), ih2);
+
+    /* Read and check samples. */
+    ReadAndCheckSampleType1(testData1, notReadState,         true);
+    ReadAndCheckSampleType1(testData2, notReadDisposedState, true);
+    ReadAndCheckSampleType1(testData3, viewedDisposedState,  true);
+}
+
 TEST_F(DataWriter, write_TopicInstance)
 {
     dds::topic::TopicInstance<Space::Type1> ti;
@@ -444,6 +483,180 @@ TEST_F(DataWriter, write_iter)
     ReadAndCheckSampleType1(samples[1], notReadState, true);
 }
 
+TEST_F(DataWriter, write_iter_TopicInstance)
+{
+    dds::sub::status::DataState notReadState(
+                        dds::sub::status::SampleState::not_read(),
+                        dds::sub::status::ViewState::new_view(),
+                        dds::sub::status::InstanceState::alive());
+
+    std::vector<dds::topic::TopicInstance<Space::Type1> > instances;
+    instances.push_back(dds::topic::TopicInstance<Space::Type1>(dds::core::null, Space::Type1(1, 2, 3)));
+    instances.push_back(dds::topic::TopicInstance<Space::Type1>(dds::core::null, Space::Type1(2, 3, 4)));
+
+    this->SetupCommunication(false);
+
+    this->writer.write(instances.begin(), instances.end());
+
+    ReadAndCheckSampleType1(instances[0].sample(), notReadState, true);
+    ReadAndCheckSampleType1(instances[1].sample(), notReadState, true);
+}
+
+TEST_F(DataWriter, write_iter_registered_TopicInstance)
+{
+    dds::sub::status::DataState notReadState(
+                        dds::sub::status::SampleState::not_read(),
+                        dds::sub::status::ViewState::new_view(),
+                        dds::sub::status::InstanceState::alive());
+
+    this->SetupCommunication(false);
+
+    /* Writes with the handles of registered instances take the key from the registration. */
+    dds::core::InstanceHandle ih1 = this->writer.register_instance(Space::Type1(1, 0, 0));
+    dds::core::InstanceHandle ih2 = this->writer.register_instance(Space::Type1(2, 0, 0));
+
+    std::vector<dds::topic::TopicInstance<Space::Type1> > instances;
+    instances.push_back(dds::topic::TopicInstance<Space::Type1>(ih1, Space::Type1(1, 2, 3)));
+    instances.push_back(dds::topic::TopicInstance<Space::Type1>(ih2, Space::Type1(2, 3, 4)));
+    instances.push_back(dds::topic::TopicInstance<Space::Type1>(dds::core::null, Space::Type1(3, 4, 5)));
+
+    this->writer.write(instances.begin(), instances.end());
+
+    ASSERT_EQ(this->writer.lookup_instance(instances[0].sample()), ih1);
+    ASSERT_EQ(this->writer.lookup_instance(instances[1].sample()), ih2);
+
+    ReadAndCheckSampleType1(instances[0].sample(), notReadState, true);
+    ReadAndCheckSampleType1(instances[1].sample(), notReadState, true);
+    ReadAndCheckSampleType1(instances[2].sample(), notReadState, true);
+}
+
+TEST_F(DataWriter, write_iter_registered_TopicInstance_async)
+{
+    dds::sub::status::DataState notReadState(
+                        dds::sub::status::SampleState::not_read(),
+                        dds::sub::status::ViewState::new_view(),
+                        dds::sub::status::InstanceState::alive());
+
+    this->SetupCommunication(false);
+    this->writer->enable_async(org::eclipse::cyclonedds::pub::AsyncWriterConfig());
+
+    /* The handles are queued along with the samples, the keys still come from the registration. */
+    dds::core::InstanceHandle ih1 = this->writer.register_instance(Space::Type1(1, 0, 0));
+    dds::core::InstanceHandle ih2 = this->writer.register_instance(Space::Type1(2, 0, 0));
+
+    std::vector<dds::topic::TopicInstance<Space::Type1> > instances;
+    instances.push_back(dds::topic::TopicInstance<Space::Type1>(ih1, Space::Type1(1, 2, 3)));
+    instances.push_back(dds::topic::TopicInstance<Space::Type1>(ih2, Space::Type1(2, 3, 4)));
+    instances.push_back(dds::topic::TopicInstance<Space::Type1>(dds::core::null, Space::Type1(3, 4, 5)));
+
+    this->writer.write(instances.begin(), instances.end());
+    this->writer.wait_for_acknowledgments(dds::core::Duration::from_secs(10));
+
+    ASSERT_EQ(this->writer->async_statistics().written, instances.size());
+    ASSERT_EQ(this->writer.lookup_instance(instances[0].sample()), ih1);
+    ASSERT_EQ(this->writer.lookup_instance(instances[1].sample()), ih2);
+
+    ReadAndCheckSampleType1(instances[0].sample(), notReadState, true);
+    ReadAndCheckSampleType1(instances[1].sample(), notReadState, true);
+    ReadAndCheckSampleType1(instances[2].sample(), notReadState, true);
+}
+
+TEST_F(DataWriter, write_iter_batch)
+{
+    dds::sub::status::DataState notReadState(
+                        dds::sub::status::SampleState::not_read(),
+                        dds::sub::status::ViewState::new_view(),
+                        dds::sub::status::InstanceState::alive());
+
+    /* All samples are of the same instance, so that they are taken in the order they were written. */
+    std::vector<Space::Type1> samples;
+    for (int32_t i = 0; i < 100; i++)
+        samples.push_back(Space::Type1(1, i, i + 1));
+
+    /* Keep all samples, and let the writer batch them until the end of the write. */
+    this->SetupWriter(true);
+    dds::pub::qos::DataWriterQos qos = this->topic.qos();
+    qos << dds::core::policy::WriterBatching::BatchUpdates();
+    this->writer = dds::pub::DataWriter<Space::Type1>(this->publisher, this->topic, qos);
+    this->CreateReader(true);
+
+    this->writer.write(samples.begin(), samples.end());
+
+    ReadAndCheckAllType1(samples, notReadState, true);
+}
+
+TEST_F(DataWriter, write_async)
+{
+    dds::sub::status::DataState notReadState(
+                        dds::sub::status::SampleState::not_read(),
+                        dds::sub::status::ViewState::new_view(),
+                        dds::sub::status::InstanceState::alive());
+
+    /* All samples are of the same instance, so that they are taken in the order they were written. */
+    std::vector<Space::Type1> samples;
+    for (int32_t i = 0; i < 100; i++)
+        samples.push_back(Space::Type1(1, i, i + 1));
+
+    this->SetupCommunication(true);
+
+    /* Several threads serialize the samples, which are still written in order. */
+    org::eclipse::cyclonedds::pub::AsyncWriterConfig config;
+    config.queue_size = 16;
+    config.threads = 3;
+    this->writer->enable_async(config);
+    ASSERT_THROW({
+        this->writer->enable_async(config);
+    }, dds::core::PreconditionNotMetError);
+
+    for (size_t i = 0; i < samples.size(); i += 2) {
+        this->writer.write(samples[i]);
+        Space::Type1 moved(samples[i + 1]);
+        this->writer->write(std::move(moved));
+    }
+
+    /* Waiting for acknowledgments first waits for the queued samples to reach ddsc. */
+    this->writer.wait_for_acknowledgments(dds::core::Duration::from_secs(10));
+
+    org::eclipse::cyclonedds::pub::AsyncWriterStatistics stats = this->writer->async_statistics();
+    ASSERT_EQ(stats.queued, samples.size());
+    ASSERT_EQ(stats.written, samples.size());
+    ASSERT_EQ(stats.failed, 0u);
+    ASSERT_EQ(stats.dropped, 0u);
+    ASSERT_EQ(stats.rejected, 0u);
+    ASSERT_EQ(stats.depth, 0u);
+    ASSERT_LE(stats.max_depth, 16u);
+
+    ReadAndCheckAllType1(samples, notReadState, true);
+}
+
+TEST_F(DataWriter, write_async_rejected)
+{
+    this->SetupCommunication(true);
+
+    /* Samples refused by the small queue do not end the wait for the ones that were queued. */
+    org::eclipse::cyclonedds::pub::AsyncWriterConfig config;
+    config.queue_size = 2;
+    config.threads = 1;
+    config.full_policy = org::eclipse::cyclonedds::pub::AsyncFullPolicy::Fail;
+    this->writer->enable_async(config);
+
+    uint64_t refused = 0;
+    for (int32_t i = 0; i < 100; i++) {
+        try {
+            this->writer.write(Space::Type1(i, i, i));
+        } catch (const dds::core::OutOfResourcesError&) {
+            refused++;
+        }
+    }
+    this->writer.wait_for_acknowledgments(dds::core::Duration::from_secs(10));
+
+    org::eclipse::cyclonedds::pub::AsyncWriterStatistics stats = this->writer->async_statistics();
+    ASSERT_EQ(stats.rejected, refused);
+    ASSERT_EQ(stats.queued + stats.rejected, 100u);
+    ASSERT_EQ(stats.written, stats.queued);
+    ASSERT_EQ(stats.depth, 0u);
+}
+
 TEST_F(DataWriter, write_data_with_timestamp)
 {
     Space::Type1 testData1(1,1,1);
@@ -592,6 +805,51 @@ TEST_F(DataWriter, write_cdr)
     ReadAndCheckSampleType1(testData, notReadState, true);
 }
 
+TEST_F(DataWriter, write_serialized_loan)
+{
+    Space::Type1 testData(0,1,2);
+    this->SetupCommunication(false);
+
+    /* Loan a buffer that is too large, fill it in native byte order and shrink it. */
+    const int32_t payload[] = {0, 1, 2};
+    org::eclipse::cyclonedds::pub::SerializedLoan loan = this->writer->loan_serialized(2 * sizeof(payload));
+    ASSERT_TRUE(static_cast<bool>(loan));
+    ASSERT_EQ(loan.capacity(), 2 * sizeof(payload));
+    memcpy(loan.data(), payload, sizeof(payload));
+    loan.resize(sizeof(payload));
+    ASSERT_THROW(loan.resize(loan.capacity() + 1), dds::core::InvalidArgumentError);
+
+    this->writer->write(std::move(loan));
+    ASSERT_FALSE(static_cast<bool>(loan));
+    ASSERT_THROW(this->writer->write(std::move(loan)), dds::core::InvalidArgumentError);
+
+    /* A loan that is not written returns its buffer. */
+    org::eclipse::cyclonedds::pub::SerializedLoan unused = this->writer->loan_serialized(sizeof(payload));
+    unused.reset();
+    ASSERT_FALSE(static_cast<bool>(unused));
+
+    /* Check result. */
+    dds::sub::status::DataState notReadState(dds::sub::status::SampleState::not_read(),
+                                             dds::sub::status::ViewState::new_view(),
+                                             dds::sub::status::InstanceState::alive());
+    ReadAndCheckSampleType1(testData, notReadState, true);
+}
+
+TEST_F(DataWriter, write_serialized_loan_representation)
+{
+    this->SetupCommunication(false);
+
+    /* The loan is serialized in the data representation of the writer, not that of the topic. */
+    org::eclipse::cyclonedds::pub::SerializedLoan loan = this->writer->loan_serialized(sizeof(int32_t));
+    ASSERT_EQ(loan.encoding(), org::eclipse::cyclonedds::core::cdr::encoding_version::xcdr_v1);
+
+    dds::pub::qos::DataWriterQos qos = this->publisher.default_datawriter_qos();
+    qos << dds::core::policy::DataRepresentation({dds::core::policy::DataRepresentationId::XCDR2});
+    dds::pub::DataWriter<Space::Type1> xcdr2_writer(this->publisher, this->topic, qos);
+    org::eclipse::cyclonedds::pub::SerializedLoan xcdr2_loan = xcdr2_writer->loan_serialized(sizeof(int32_t));
+    ASSERT_EQ(xcdr2_loan.encoding(), org::eclipse::cyclonedds::core::cdr::encoding_version::xcdr_v2);
+}
+
 TEST_F(DataWriter, writedispose)
 {
     Space::Type1 testData0(0,0,0);
@@ -745,6 +1003,23 @@ TEST_F(DataWriter, dispose_instance_after_read)
     this->ReadAndCheckAllType1(testDataList, readDisposedState, true);
 }
 
+TEST_F(DataWriter, wait_for_acknowledgments)
+{
+    Space::Type1 testData(1,2,3);
+    dds::sub::status::DataState notReadState(dds::sub::status::SampleState::not_read(),
+                                             dds::sub::status::ViewState::new_view(),
+                                             dds::sub::status::InstanceState::alive());
+
+    /* Reliable writer and reader. */
+    this->SetupCommunication(true);
+    this->writer.write(testData);
+
+    /* The reader in the same participant acknowledges the sample. */
+    this->writer.wait_for_acknowledgments(dds::core::Duration::from_secs(10));
+
+    ReadAndCheckSampleType1(testData, notReadState, true);
+}
+
 TEST_F(DataWriter, matched_subscriptions_sequence)
 {
     this->SetupCommunication(false);
@@ -1014,6 +1289,10 @@ TEST_F(DataWriter, use_after_close)
         this->writer >> qos;
     }, dds::core::AlreadyClosedError);
 
+    ASSERT_THROW({
+        this->writer.wait_for_acknowledgments(dds::core::Duration::from_secs(1));
+    }, dds::core::AlreadyClosedError);
+
     ASSERT_THROW({
         this->writer.write(testData);
     }, dds::core::AlreadyClosedError);
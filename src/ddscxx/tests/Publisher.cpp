@@ -130,6 +130,60 @@ TEST_F(Publisher, default__qos)
     this->publisher.default_datawriter_qos(wQos);
 }
 
+TEST_F(Publisher, suspend_publications)
+{
+    this->CreatePublisher();
+    dds::topic::Topic<Space::Type1> topic(this->participant, "publisher_suspend_publications");
+    dds::pub::DataWriter<Space::Type1> writer1(this->publisher, topic);
+    dds::pub::DataWriter<Space::Type1> writer2(this->publisher, topic);
+    dds::sub::DataReader<Space::Type1> reader(dds::sub::Subscriber(this->participant), topic);
+
+    {
+        dds::pub::SuspendedPublication suspended(this->publisher);
+        writer1.write(Space::Type1(1, 1, 1));
+        writer2.write(Space::Type1(2, 2, 2));
+        writer1.writedispose(Space::Type1(3, 3, 3));
+
+        /* Nothing is published until the publication is resumed. */
+        ASSERT_EQ(reader.take().length(), 0u);
+    }
+
+    dds::sub::LoanedSamples<Space::Type1> samples = reader.take();
+    ASSERT_EQ(samples.length(), 3u);
+}
+
+TEST_F(Publisher, suspend_publications_thresholds)
+{
+    this->CreatePublisher();
+    dds::topic::Topic<Space::Type1> topic(this->participant, "publisher_suspend_publications_thresholds");
+    dds::pub::DataWriter<Space::Type1> writer(this->publisher, topic);
+    dds::sub::DataReader<Space::Type1> reader(dds::sub::Subscriber(this->participant), topic);
+
+    /* Flushed every two samples. */
+    this->publisher->suspend_publications(2, 0, dds::core::Duration::infinite());
+    writer.write(Space::Type1(1, 1, 1));
+    ASSERT_EQ(reader.take().length(), 0u);
+    writer.write(Space::Type1(2, 2, 2));
+    ASSERT_EQ(reader.take().length(), 2u);
+    this->publisher->resume_publications();
+
+    /* Flushed once the oldest sample has been queued for 10ms. */
+    this->publisher->suspend_publications(0, 0, dds::core::Duration::from_millisecs(10));
+    writer.write(Space::Type1(3, 3, 3));
+    uint32_t taken = 0;
+    for (int i = 0; i < 200 && taken == 0; i++) {
+        taken = reader.take().length();
+        if (taken == 0)
+            dds_sleepfor(DDS_MSECS(10));
+    }
+    ASSERT_EQ(taken, 1u);
+    this->publisher->resume_publications();
+
+    ASSERT_THROW({
+        this->publisher->resume_publications();
+    }, dds::core::PreconditionNotMetError);
+}
+
 TEST_F(Publisher, use_after_close)
 {
     /* Get closed publisher. */
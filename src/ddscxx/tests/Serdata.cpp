@@ -12,6 +12,7 @@
 
 #include "dds/dds.hpp"
 #include "Serialization.hpp"
+#include "ViewModels.hpp"
 #include <org/eclipse/cyclonedds/topic/datatopic.hpp>
 
 using namespace org::eclipse::cyclonedds::core::cdr;
@@ -29,6 +30,37 @@ public:
     {
     }
 
+    /* Owns a sertype of T created for a test, and frees it when going out of scope. */
+    template<typename T, typename S = xcdr_v1_stream>
+    class scoped_sertype
+    {
+    public:
+        scoped_sertype()
+            : m_type(org::eclipse::cyclonedds::topic::TopicTraits<T>::getSerType(
+                std::is_same<S, xcdr_v2_stream>::value ? DDS_DATA_REPRESENTATION_FLAG_XCDR2 : DDS_DATA_REPRESENTATION_FLAG_XCDR1))
+        {
+        }
+
+        scoped_sertype(const scoped_sertype&) = delete;
+        scoped_sertype& operator=(const scoped_sertype&) = delete;
+
+        ~scoped_sertype()
+        {
+            if (m_type == nullptr)
+                return;
+            //hacky and ugly, but we cannot call the sertype_free function, as the C type is referenced nowhere
+            dds_free(m_type->type_name);
+            delete static_cast<ddscxx_sertype<T,S>*>(m_type);
+        }
+
+        ddsi_sertype* get() const { return m_type; }
+        operator ddsi_sertype*() const { return m_type; }
+        ddsi_sertype* operator->() const { return m_type; }
+
+    private:
+        ddsi_sertype *m_type;
+    };
+
     void SetUp()
     {
         m_st = org::eclipse::cyclonedds::topic::TopicTraits<Endianness::Msg>::getSerType(DDS_DATA_REPRESENTATION_FLAG_XCDR1);
@@ -243,7 +275,7 @@ using kh_t = std::array<unsigned char, 16>;
 template<typename T>
 static void test_keyhash(const T& sample, const kh_t& expected, const kh_t& expected_md5)
 {
-    auto st = org::eclipse::cyclonedds::topic::TopicTraits<T>::getSerType(DDS_DATA_REPRESENTATION_FLAG_XCDR1);
+    Serdata::scoped_sertype<T> st;
     auto sd = serdata_from_sample<T, org::eclipse::cyclonedds::core::cdr::xcdr_v1_stream>(st, SDK_DATA, &sample);
     ASSERT_GT(sd->hash, static_cast<uint32_t>(0));
     struct ddsi_keyhash khraw, khraw_md5;
@@ -255,9 +287,6 @@ static void test_keyhash(const T& sample, const kh_t& expected, const kh_t& expe
     ASSERT_EQ(kh, expected);
     ASSERT_EQ(kh_md5, expected_md5);
     delete static_cast<ddscxx_serdata<T> *>(sd);
-    //hacky and ugly, but we cannot call the sertype_free function, as the C type is referenced nowhere
-    dds_free(st->type_name);
-    delete static_cast<ddscxx_sertype<T,org::eclipse::cyclonedds::core::cdr::xcdr_v1_stream>*>(st);
 }
 
 TEST_F(Serdata, keyhash_nokey)
@@ -309,3 +338,555 @@ TEST_F(Serdata, keyhash_bstringkey)
     const kh_t kh_md5{0x39, 0x59, 0x90, 0xf2, 0x0f, 0xd2, 0x53, 0x5a, 0x54, 0x07, 0xec, 0xa5, 0x65, 0xcc, 0xd2, 0xd7};
     test_keyhash<T>(v, kh, kh_md5);
 }
+
+/*
+ * Checking that the key size determined by idlcxx matches the one determined at runtime, and that
+ * key samples are reconstructed from keyhashes which contain the key itself.
+ */
+template<typename T>
+static void test_from_keyhash(const T& sample, size_t key_size)
+{
+    using S = org::eclipse::cyclonedds::core::cdr::xcdr_v1_stream;
+    ASSERT_EQ(org::eclipse::cyclonedds::topic::TopicTraits<T>::keyMaxSize(), key_size);
+    if (key_size != SIZE_MAX)
+      ASSERT_EQ(max_key_size(T()), key_size);
+
+    Serdata::scoped_sertype<T, S> st;
+    auto sd = serdata_from_sample<T, S>(st, SDK_DATA, &sample);
+    ASSERT_NE(sd, nullptr);
+    struct ddsi_keyhash kh;
+    serdata_get_keyhash<T>(sd, &kh, false);
+
+    auto kd = serdata_from_keyhash<T, S>(st, &kh);
+    if (key_size > sizeof(kh.value)) {
+      ASSERT_EQ(kd, nullptr);
+    } else {
+      ASSERT_NE(kd, nullptr);
+      ASSERT_EQ(kd->kind, SDK_KEY);
+      ASSERT_TRUE(serdata_eqkey<T>(sd, kd));
+      ASSERT_EQ(kd->hash, sd->hash);
+      delete static_cast<ddscxx_serdata<T> *>(kd);
+    }
+
+    delete static_cast<ddscxx_serdata<T> *>(sd);
+}
+
+TEST_F(Serdata, from_keyhash)
+{
+    test_from_keyhash(Keyhash::SmallKey{0x12345678, 0xabcdef01}, 4);
+    test_from_keyhash(Keyhash::LargeKey{{1,2,3,4,5}, 0xabcdef01}, 20);
+    test_from_keyhash(Keyhash::StringKey{"Ick sie boven uut mijnen throne", 0xabcdef01}, SIZE_MAX);
+    test_from_keyhash(Keyhash::BStringKey{"Elckerlijc", 0xabcdef01}, 16);
+    //the key members are written in member id order: l, c and both members of p
+    test_from_keyhash(Keyhash::SortedKey{0xabcdef01, {0x1234, 'a'}, 'b', 0x12345678}, 9);
+}
+
+/*
+ * Checking that received data is deserialized on receipt, so that samples which are truncated after
+ * their key members are rejected, and that the untyped key of data which holds no sample is read
+ * from its serialized key members.
+ */
+template<typename T, typename S>
+static void test_key_from_ser(const T& sample, bool key_readable)
+{
+    ASSERT_EQ(org::eclipse::cyclonedds::topic::TopicTraits<T>::isKeyReadableFromData(), key_readable);
+
+    Serdata::scoped_sertype<T, S> st;
+    auto sd = serdata_from_sample<T, S>(st, SDK_DATA, &sample);
+    ASSERT_NE(sd, nullptr);
+
+    auto wd = static_cast<ddscxx_serdata<T> *>(sd);
+    ddsrt_iovec_t iov;
+    iov.iov_base = wd->data();
+    iov.iov_len = static_cast<ddsrt_iov_len_t>(wd->size());
+    auto rd = static_cast<ddscxx_serdata<T> *>(serdata_from_ser_iov<T>(st, SDK_DATA, 1, &iov, wd->size()));
+    ASSERT_NE(rd, nullptr);
+    ASSERT_NE(rd->peekT(), nullptr);
+    EXPECT_EQ(*rd->peekT(), sample);
+    EXPECT_TRUE(serdata_eqkey<T>(sd, rd));
+    EXPECT_EQ(rd->hash, sd->hash);
+
+    //truncated samples are rejected, also if only non-key members are cut off
+    iov.iov_len = static_cast<ddsrt_iov_len_t>(wd->size() - 4);
+    EXPECT_EQ(serdata_from_ser_iov<T>(st, SDK_DATA, 1, &iov, wd->size() - 4), nullptr);
+
+    auto nd = new ddscxx_serdata<T>(st, SDK_DATA);
+    nd->resize(wd->size());
+    memcpy(nd->data(), wd->data(), wd->size());
+    nd->hash = wd->hash;
+    auto ud = static_cast<ddscxx_serdata<T> *>(serdata_to_untyped<T, S>(nd));
+    ASSERT_NE(ud, nullptr);
+    EXPECT_EQ(nd->peekT(), nullptr);
+    EXPECT_EQ(memcmp(ud->key().value, wd->key().value, sizeof(ud->key().value)), 0);
+    EXPECT_EQ(ud->hash, wd->hash);
+
+    delete ud;
+    delete nd;
+    delete rd;
+    delete wd;
+}
+
+TEST_F(Serdata, key_from_ser)
+{
+    using org::eclipse::cyclonedds::core::cdr::xcdr_v1_stream;
+    using org::eclipse::cyclonedds::core::cdr::xcdr_v2_stream;
+    const Keyhash::SmallKey sk{0x12345678, 0xabcdef01};
+    const Keyhash::StringKey strk{"Ick sie boven uut mijnen throne", 0xabcdef01};
+    //the key members do not precede the other members, so the whole sample is read for the key
+    const Keyhash::SortedKey sortk{0xabcdef01, {0x1234, 'a'}, 'b', 0x12345678};
+    //the members of mutable types are delimited, so the key members can be found anywhere
+    const Keyhash::MutableKey mk{0xabcdef01, "Elckerlijc", {0x1234, 'a'}};
+
+    test_key_from_ser<Keyhash::SmallKey, xcdr_v1_stream>(sk, true);
+    test_key_from_ser<Keyhash::SmallKey, xcdr_v2_stream>(sk, true);
+    test_key_from_ser<Keyhash::StringKey, xcdr_v2_stream>(strk, true);
+    test_key_from_ser<Keyhash::SortedKey, xcdr_v2_stream>(sortk, false);
+    test_key_from_ser<Keyhash::MutableKey, xcdr_v1_stream>(mk, true);
+    test_key_from_ser<Keyhash::MutableKey, xcdr_v2_stream>(mk, true);
+}
+
+/*
+ * Checking that completing a serialized loan reads its key without keeping a deserialized sample.
+ */
+template<typename T>
+static void test_from_loan(const T& sample)
+{
+    Serdata::scoped_sertype<T> st;
+    auto wd = static_cast<ddscxx_serdata<T> *>(serdata_from_sample<T, xcdr_v1_stream>(st, SDK_DATA, &sample));
+    ASSERT_NE(wd, nullptr);
+
+    const size_t payload_size = wd->size() - DDSI_RTPS_HEADER_SIZE;
+    unsigned char *payload = nullptr;
+    encoding_version version = encoding_version::xcdr_v2;
+    auto ld = static_cast<ddscxx_serdata<T> *>(serdata_loan<T>(st, payload_size, payload, version));
+    ASSERT_NE(ld, nullptr);
+    EXPECT_EQ(version, encoding_version::xcdr_v1);
+    memcpy(payload, static_cast<const unsigned char *>(wd->data()) + DDSI_RTPS_HEADER_SIZE, payload_size);
+
+    ASSERT_TRUE(serdata_from_loan<T>(ld, payload_size));
+    EXPECT_EQ(ld->peekT(), nullptr);
+    EXPECT_TRUE(serdata_eqkey<T>(wd, ld));
+    EXPECT_EQ(ld->hash, wd->hash);
+
+    delete ld;
+    delete wd;
+}
+
+TEST_F(Serdata, from_loan)
+{
+    //the key is read by itself
+    test_from_loan(Keyhash::SmallKey{0x12345678, 0xabcdef01});
+    //the whole sample is read to get the key
+    test_from_loan(Keyhash::SortedKey{0xabcdef01, {0x1234, 'a'}, 'b', 0x12345678});
+}
+
+/*
+ * Checking that taking a sample moves it out of the serdata only if nothing else refers to it.
+ */
+TEST_F(Serdata, take_moves_sample)
+{
+    using T = Keyhash::StringKey;
+    using S = org::eclipse::cyclonedds::core::cdr::xcdr_v1_stream;
+    scoped_sertype<T, S> st;
+    const T sample{"Ick sie boven uut mijnen throne", 0xabcdef01};
+    auto sd = static_cast<ddscxx_serdata<T> *>(serdata_from_sample<T, S>(st, SDK_DATA, &sample));
+    ASSERT_NE(sd, nullptr);
+
+    //reads and shared serdata copy the sample, leaving it intact in the serdata
+    T out;
+    ASSERT_TRUE(sd->extractT(out, false));
+    EXPECT_EQ(out, sample);
+    EXPECT_EQ(*sd->peekT(), sample);
+    ddsi_serdata_ref(sd);
+    T shared;
+    ASSERT_TRUE(sd->extractT(shared, true));
+    EXPECT_EQ(shared, sample);
+    EXPECT_EQ(*sd->peekT(), sample);
+    ddsi_serdata_unref(sd);
+
+    //taking the only reference moves the sample, the serdata is not accessed after this
+    T taken;
+    ASSERT_TRUE(sd->extractT(taken, true));
+    EXPECT_EQ(taken, sample);
+
+    delete sd;
+}
+
+/*
+ * Checking that the hash used in memory only depends on the key, and that it is not changed by
+ * calculating the md5 keyhash on request.
+ */
+TEST_F(Serdata, instance_hash)
+{
+    using T = Keyhash::SmallKey;
+    using S = org::eclipse::cyclonedds::core::cdr::xcdr_v1_stream;
+    scoped_sertype<T, S> st;
+    const T v1{0x12345678, 0xabcdef01}, v2{0x12345678, 0x01fedcba}, v3{0x12345679, 0xabcdef01};
+    auto sd1 = serdata_from_sample<T, S>(st, SDK_DATA, &v1);
+    auto sd2 = serdata_from_sample<T, S>(st, SDK_DATA, &v2);
+    auto sd3 = serdata_from_sample<T, S>(st, SDK_DATA, &v3);
+    ASSERT_NE(sd1, nullptr);
+    ASSERT_NE(sd2, nullptr);
+    ASSERT_NE(sd3, nullptr);
+
+    EXPECT_EQ(sd1->hash, sd2->hash);
+    EXPECT_NE(sd1->hash, sd3->hash);
+    EXPECT_EQ(sd1->hash, org::eclipse::cyclonedds::topic::key_hash(static_cast<ddscxx_serdata<T>*>(sd1)->key()) ^ st->serdata_basehash);
+
+    const uint32_t h = sd1->hash;
+    struct ddsi_keyhash kh;
+    serdata_get_keyhash<T>(sd1, &kh, true);
+    EXPECT_EQ(sd1->hash, h);
+
+    for (auto sd:{sd1, sd2, sd3})
+        delete static_cast<ddscxx_serdata<T> *>(sd);
+}
+
+/*
+ * Checking that sertypes of the same type and data representation are equal and hash alike, and
+ * that sertypes of different types or data representations are told apart, so that the sertype
+ * registry of ddsi does not put all C++ sertypes in a single bucket.
+ */
+TEST_F(Serdata, sertype_hash_equal)
+{
+    using namespace org::eclipse::cyclonedds::topic;
+    using S1 = org::eclipse::cyclonedds::core::cdr::xcdr_v1_stream;
+    using S2 = org::eclipse::cyclonedds::core::cdr::xcdr_v2_stream;
+    scoped_sertype<Keyhash::SmallKey, S1> small_v1;
+    scoped_sertype<Keyhash::SmallKey, S1> small_v1_b;
+    scoped_sertype<Keyhash::SmallKey, S2> small_v2;
+    scoped_sertype<Keyhash::LargeKey, S1> large_v1;
+    scoped_sertype<Keyhash::StringKey, S1> string_v1;
+    ASSERT_NE(small_v1.get(), nullptr);
+    ASSERT_NE(small_v1_b.get(), nullptr);
+    ASSERT_NE(small_v2.get(), nullptr);
+    ASSERT_NE(large_v1.get(), nullptr);
+    ASSERT_NE(string_v1.get(), nullptr);
+
+    EXPECT_TRUE(small_v1->ops->equal(small_v1, small_v1_b));
+    EXPECT_EQ(small_v1->ops->hash(small_v1), small_v1_b->ops->hash(small_v1_b));
+
+    EXPECT_FALSE(small_v1->ops->equal(small_v1, small_v2));
+    EXPECT_FALSE(small_v1->ops->equal(small_v1, large_v1));
+    EXPECT_NE(small_v1->ops->hash(small_v1), small_v2->ops->hash(small_v2));
+    EXPECT_NE(small_v1->ops->hash(small_v1), large_v1->ops->hash(large_v1));
+    EXPECT_NE(large_v1->ops->hash(large_v1), string_v1->ops->hash(string_v1));
+
+    /* properties set at creation are part of the identity of the sertype */
+    small_v1_b->data_type_props ^= DDS_DATA_TYPE_IS_MEMCPY_SAFE;
+    EXPECT_FALSE(small_v1->ops->equal(small_v1, small_v1_b));
+}
+
+/*
+ * Checking that samples serialized in a single pass, using the size hint of the sertype,
+ * are identical to those serialized after calculating their exact size.
+ */
+TEST_F(Serdata, serialization_size_hint)
+{
+    using T = Endianness::Seqs;
+    scoped_sertype<T> st;
+
+    const std::vector<T> samples {
+      T({true}, {'a'}, {1}, {2}, {3}),
+      T({true}, {'a','b','c'}, {1,2,3}, {2,3,4}, {3,4,5}),
+      T({true,false}, std::vector<char>(100, 'a'), std::vector<int16_t>(50, 1), {2}, std::vector<int64_t>(30, 3)),
+      T({true}, {'a'}, {1}, {2}, {3}),
+      T({}, {}, {}, {}, {})};
+
+    for (const auto &sample:samples) {
+      xcdr_v1_stream str;
+      ASSERT_TRUE(move(str, sample, key_mode::not_key));
+      size_t sz = str.position() + DDSI_RTPS_HEADER_SIZE;
+      std::vector<unsigned char> expected(sz + (0 - sz) % 4, 0x0);
+      ASSERT_TRUE((serialize_into<T, xcdr_v1_stream>(expected.data(), sz, sample, key_mode::not_key)));
+
+      auto sd = static_cast<ddscxx_serdata<T>*>(serdata_from_sample<T, xcdr_v1_stream>(st, SDK_DATA, &sample));
+      ASSERT_NE(sd, nullptr);
+      ASSERT_EQ(sd->size(), expected.size());
+      ASSERT_EQ(0, memcmp(sd->data(), expected.data(), expected.size()));
+      delete sd;
+    }
+}
+
+/*
+ * Checking that a sample serialized into a buffer sized by a much larger size hint does not keep
+ * that buffer, and that the size hint only shrinks after a run of small samples.
+ */
+TEST_F(Serdata, size_hint_shrink)
+{
+    using T = Endianness::Seqs;
+    scoped_sertype<T> st;
+    auto sertype = static_cast<const ddscxx_sertype<T, xcdr_v1_stream>*>(st.get());
+    auto inside = [](const ddscxx_serdata<T> *sd, const void *p) {
+      auto begin = reinterpret_cast<const unsigned char*>(sd);
+      auto q = static_cast<const unsigned char*>(p);
+      return q >= begin && q < begin + sizeof(*sd);
+    };
+    auto write = [&st](const T &sample) {
+      auto sd = static_cast<ddscxx_serdata<T>*>(serdata_from_sample<T, xcdr_v1_stream>(st, SDK_DATA, &sample));
+      EXPECT_NE(sd, nullptr);
+      return sd;
+    };
+
+    const T small({true}, {'a'}, {1}, {2}, {3}),
+            large({true}, {'a'}, {1}, {2}, std::vector<int64_t>(100, 3));
+
+    delete write(large);
+    const size_t large_hint = sertype->size_hint();
+    ASSERT_GT(large_hint, 800u);
+
+    //the small sample is moved out of the buffer sized for the large one
+    auto sd = write(small);
+    EXPECT_TRUE(inside(sd, sd->data()));
+    delete sd;
+    EXPECT_EQ(sertype->size_hint(), large_hint);
+
+    //alternating sample sizes keep the hint
+    for (int i = 0; i < 20; i++)
+      delete write(i % 2 ? large : small);
+    EXPECT_EQ(sertype->size_hint(), large_hint);
+
+    //a run of small samples shrinks it
+    for (int i = 0; i < 16; i++)
+      delete write(small);
+    EXPECT_LT(sertype->size_hint(), large_hint / 4);
+}
+
+/*
+ * Checking that received samples are deserialized into recycled samples if the pool is enabled,
+ * without keeping any contents of the previous sample.
+ */
+TEST_F(Serdata, sample_recycling)
+{
+    using T = Endianness::Seqs;
+    using org::eclipse::cyclonedds::topic::sample_pool;
+    static_assert(org::eclipse::cyclonedds::topic::TopicTraits<T>::isRecyclable(), "Seqs should be recyclable");
+
+    scoped_sertype<T> st;
+    auto &pool = sample_pool<T>::instance();
+    pool.capacity(1);
+
+    auto received = [&st](const T &sample) {
+      size_t sz = 0;
+      EXPECT_TRUE((get_serialized_size<T, xcdr_v1_stream, key_mode::not_key>(sample, sz)));
+      sz += DDSI_RTPS_HEADER_SIZE;
+      auto sd = new ddscxx_serdata<T>(st, SDK_DATA);
+      sd->resize(sz);
+      EXPECT_TRUE((serialize_into<T, xcdr_v1_stream>(sd->data(), sz, sample, key_mode::not_key)));
+      return sd;
+    };
+
+    const T large({true, false}, std::vector<char>(100, 'a'), std::vector<int16_t>(50, 1), {2}, std::vector<int64_t>(30, 3)),
+            small({false}, {'b'}, {}, {4, 5}, {});
+
+    auto sd = received(large);
+    T *first = sd->getT();
+    ASSERT_NE(first, nullptr);
+    ASSERT_EQ(*first, large);
+    delete sd;
+    ASSERT_EQ(pool.size(), 1u);
+
+    sd = received(small);
+    T *second = sd->getT();
+    ASSERT_EQ(second, first);
+    ASSERT_EQ(*second, small);
+    ASSERT_GE(second->c_seq().capacity(), 100u);
+    ASSERT_EQ(pool.size(), 0u);
+    delete sd;
+    ASSERT_EQ(pool.size(), 1u);
+
+    //the copies of written samples are not recycled
+    sd = static_cast<ddscxx_serdata<T> *>(serdata_from_sample<T, xcdr_v1_stream>(st, SDK_DATA, &large));
+    ASSERT_NE(sd, nullptr);
+    delete sd;
+    ASSERT_EQ(pool.size(), 1u);
+
+    pool.capacity(0);
+    ASSERT_EQ(pool.size(), 0u);
+}
+
+/*
+ * Checking that serdata and their buffers are taken from the pool once it is enabled, so that
+ * writing samples no longer obtains memory from the memory resource once the pool is filled.
+ */
+class counting_resource : public org::eclipse::cyclonedds::topic::memory_resource
+{
+public:
+    size_t live = 0;
+
+    void *allocate(size_t bytes, size_t) { live++; return ::operator new(bytes); }
+    void deallocate(void *p, size_t, size_t) { live--; ::operator delete(p); }
+};
+
+TEST_F(Serdata, serdata_pooling)
+{
+    using T = Endianness::Seqs;
+    using org::eclipse::cyclonedds::topic::serdata_pool;
+
+    scoped_sertype<T> st;
+    auto &pool = serdata_pool<T>::instance();
+    counting_resource mr;
+    pool.resource(&mr);
+    pool.capacity(8);
+
+    auto write = [&st](const T &sample) {
+      auto sd = serdata_from_sample<T, xcdr_v1_stream>(st, SDK_DATA, &sample);
+      ASSERT_NE(sd, nullptr);
+      delete static_cast<ddscxx_serdata<T>*>(sd);
+    };
+
+    const T small({true}, {'a'}, {1}, {2}, {3}),
+            large({true}, {'a'}, {1}, {2}, std::vector<int64_t>(10000, 3));
+    write(small);
+    auto before = pool.statistics();
+    for (size_t i = 0; i < 100; i++)
+      write(small);
+    auto after = pool.statistics();
+    ASSERT_EQ(after.allocations, before.allocations);
+    ASSERT_EQ(after.deallocations, before.deallocations);
+
+    //buffers which are too large for the pool are not kept
+    write(large);
+    after = pool.statistics();
+    ASSERT_EQ(after.allocations, before.allocations + 1);
+    ASSERT_EQ(after.deallocations, before.deallocations + 1);
+
+    pool.capacity(0);
+    ASSERT_EQ(mr.live, 0u);
+
+    //while pooling is disabled, memory is not taken from the resource nor counted, and it is
+    //returned to where it came from if pooling is enabled while it is in use
+    before = pool.statistics();
+    write(small);
+    auto sd = serdata_from_sample<T, xcdr_v1_stream>(st, SDK_DATA, &large);
+    ASSERT_NE(sd, nullptr);
+    pool.capacity(8);
+    delete static_cast<ddscxx_serdata<T>*>(sd);
+    pool.capacity(0);
+    after = pool.statistics();
+    ASSERT_EQ(after.allocations, before.allocations);
+    ASSERT_EQ(after.deallocations, before.deallocations);
+    ASSERT_EQ(mr.live, 0u);
+    pool.resource(nullptr);
+}
+
+/*
+ * Checking that the serialized data of small samples is stored in the serdata itself, and that
+ * of large samples separately, and that the sample of data is stored right behind the serdata.
+ */
+TEST_F(Serdata, inline_storage)
+{
+    using T = Endianness::Seqs;
+
+    scoped_sertype<T> st;
+    auto inside = [](const ddscxx_serdata<T> *sd, const void *p) {
+      auto begin = reinterpret_cast<const unsigned char*>(sd);
+      auto q = static_cast<const unsigned char*>(p);
+      return q >= begin && q < begin + sizeof(*sd);
+    };
+    auto behind = [](const ddscxx_serdata<T> *sd, const void *p) {
+      auto end = reinterpret_cast<const unsigned char*>(sd) + sizeof(*sd);
+      auto q = static_cast<const unsigned char*>(p);
+      return q >= end && q < end + alignof(T);
+    };
+
+    const T small({true}, {'a'}, {1}, {2}, {3}),
+            large({true}, {'a'}, {1}, {2}, std::vector<int64_t>(100, 3));
+    auto sd = static_cast<ddscxx_serdata<T>*>(serdata_from_sample<T, xcdr_v1_stream>(st, SDK_DATA, &small));
+    ASSERT_NE(sd, nullptr);
+    ASSERT_TRUE(inside(sd, sd->data()));
+    ASSERT_TRUE(behind(sd, sd->getT()));
+    ASSERT_EQ(*sd->getT(), small);
+    delete sd;
+
+    sd = static_cast<ddscxx_serdata<T>*>(serdata_from_sample<T, xcdr_v1_stream>(st, SDK_DATA, &large));
+    ASSERT_NE(sd, nullptr);
+    ASSERT_FALSE(inside(sd, sd->data()));
+    ASSERT_TRUE(behind(sd, sd->getT()));
+    ASSERT_EQ(*sd->getT(), large);
+    delete sd;
+
+    //serdata of keys have no room for a sample
+    sd = static_cast<ddscxx_serdata<T>*>(serdata_from_sample<T, xcdr_v1_stream>(st, SDK_KEY, &small));
+    ASSERT_NE(sd, nullptr);
+    ASSERT_FALSE(behind(sd, sd->getT()));
+    delete sd;
+}
+
+/*
+ * Checking that views only deserialize the members which are accessed for final types,
+ * and fall back to deserializing the whole sample for other types.
+ * Strings can be referred to in the received data without copying them.
+ */
+template<typename T, typename S>
+ddscxx_serdata<T> *received_sample(const ddsi_sertype *st, const T &sample)
+{
+    S str;
+    EXPECT_TRUE(move(str, sample, key_mode::not_key));
+    size_t sz = str.position() + DDSI_RTPS_HEADER_SIZE;
+    auto sd = new ddscxx_serdata<T>(st, SDK_DATA);
+    sd->resize(sz);
+    EXPECT_TRUE((serialize_into<T, S>(sd->data(), sz, sample, key_mode::not_key)));
+    return sd;
+}
+
+template<typename S>
+void test_lazy_view(const ddsi_sertype *st)
+{
+    using T = Views::Msg;
+    const T first(1, 2.5, "first", {1, 2, 3}, 4),
+            second(5, 6.5, "the second sample", {}, 7);
+
+    for (const auto &sample:{first, second, first}) {
+      auto sd = received_sample<T, S>(st, sample);
+      {
+        Views::Msg_view view(sd);
+        auto name = view.name_view();
+        ASSERT_EQ(std::string(name.data(), name.size()), sample.name());
+        auto buffer = static_cast<const char*>(sd->data());
+        ASSERT_TRUE(name.data() > buffer && name.data() < buffer + sd->size());
+        auto values = view.values_view();
+        ASSERT_EQ(std::vector<int32_t>(values.begin(), values.end()), sample.values());
+
+        ASSERT_EQ(view.s(), sample.s());
+        ASSERT_EQ(view.d(), sample.d());
+        ASSERT_EQ(view.name(), sample.name());
+        ASSERT_EQ(view.values(), sample.values());
+        ASSERT_EQ(view.id(), sample.id());
+        ASSERT_EQ(sd->peekT(), nullptr);
+
+        //a copy does not take over the deserialized members, it reads them again
+        Views::Msg_view copy(view);
+        ASSERT_EQ(copy.name(), sample.name());
+        ASSERT_EQ(copy.id(), sample.id());
+        ASSERT_EQ(sd->peekT(), nullptr);
+        ASSERT_EQ(copy.full_sample(), sample);
+        ASSERT_NE(sd->peekT(), nullptr);
+      }
+      delete sd;
+    }
+}
+
+TEST_F(Serdata, lazy_view)
+{
+    scoped_sertype<Views::Msg> st;
+
+    test_lazy_view<xcdr_v1_stream>(st);
+    test_lazy_view<xcdr_v2_stream>(st);
+}
+
+TEST_F(Serdata, lazy_view_fallback)
+{
+    using T = Views::AppendableMsg;
+    scoped_sertype<T, xcdr_v2_stream> st;
+
+    const T sample(1, "appendable");
+    auto sd = received_sample<T, xcdr_v2_stream>(st, sample);
+    {
+      Views::AppendableMsg_view view(sd);
+      ASSERT_EQ(view.name(), sample.name());
+      ASSERT_NE(sd->peekT(), nullptr);
+      ASSERT_EQ(view.id(), sample.id());
+    }
+    delete sd;
+}
@@ -579,6 +579,43 @@ bool is_selfcontained(const void *node)
   return true;
 }
 
+static bool rc_struct(const idl_struct_t *str)
+{
+  if (get_extensibility(str) != IDL_FINAL)
+    return false;
+
+  const idl_member_t *mem = NULL;
+  IDL_FOREACH(mem, str->members) {
+    if (is_external(mem) || is_optional(mem) || !is_recyclable(mem->type_spec))
+      return false;
+  }
+
+  if (str->inherit_spec)
+    return is_recyclable(str->inherit_spec->base);
+
+  return true;
+}
+
+bool is_recyclable(const void *node)
+{
+  if (idl_is_forward(node)) {
+    /*the type may be recursive, do not follow it*/
+    return false;
+  } else if (idl_is_sequence(node)) {
+    return is_recyclable(((const idl_sequence_t*)node)->type_spec);
+  } else if (idl_is_typedef(node)) {
+    return is_recyclable(((const idl_typedef_t*)node)->type_spec);
+  } else if (idl_is_struct(node)) {
+    return rc_struct((const idl_struct_t*)node);
+  } else if (idl_is_declarator(node)) {
+    const idl_node_t *parent = ((const idl_node_t*)node)->parent;
+    assert (idl_is_typedef(parent));
+    return is_recyclable(parent);
+  }
+  /*unions are read into a newly constructed branch, so they never contain stale members*/
+  return true;
+}
+
 idl_extensibility_t
 get_extensibility(const void *node)
 {
@@ -1091,6 +1128,8 @@ idl_retcode_t generate_nosetup(const idl_pstate_t *pstate, struct generator *gen
     goto err_print;
   if ((ret = generate_streamers(pstate, gen)))
     goto err_print;
+  if (gen->generate_views && (ret = generate_views(pstate, gen)))
+    goto err_print;
   if ((ret = print_guard_endif(gen->header.handle, guard)))
     goto err_print;
   free(guard);
@@ -1125,6 +1164,7 @@ const char *uni_inc = "<variant>";
 #endif
 const char *ext_tmpl = "dds::core::external";
 const char *ext_inc = "<dds/core/External.hpp>";
+int gen_views = 0;
 
 static const char *arr_toks[] = { "TYPE", "DIMENSION", NULL };
 static const char *arr_flags[] = { "s", PRIu32, NULL };
@@ -1179,6 +1219,7 @@ idl_retcode_t generate(const idl_pstate_t *pstate, const idlc_generator_config_t
   gen.optional_include = opt_inc;
   gen.union_include = uni_inc;
   gen.external_include = ext_inc;
+  gen.generate_views = (gen_views != 0);
 
   /* invoke code generation */
   ret = generate_nosetup(pstate, &gen);
@@ -1300,6 +1341,12 @@ static const idlc_option_t *opts[] = {
     'f', "union-include", "<header>",
     "Header to include if template for union-template is used."
   },
+  &(idlc_option_t) {
+    IDLC_FLAG, { .flag = &gen_views },
+    'f', "views", "",
+    "Generate a read-only view class (TYPE_view) for each topic type, which "
+    "deserializes members of a received sample only when they are accessed."
+  },
   NULL
 };
 
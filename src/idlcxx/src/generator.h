@@ -42,6 +42,7 @@ struct generator {
   bool uses_union;
   bool uses_optional;
   bool uses_external;
+  bool generate_views;
   struct {
     FILE *handle;
     char *path;
@@ -88,6 +89,9 @@ bool is_nested(
 bool is_selfcontained(
   const void *node);
 
+bool is_recyclable(
+  const void *node);
+
 idl_extensibility_t get_extensibility(
   const void *node);
 
@@ -103,4 +107,7 @@ generate_traits(const idl_pstate_t *pstate, struct generator *generator);
 idl_retcode_t
 generate_types(const idl_pstate_t *pstate, struct generator *generator);
 
+idl_retcode_t
+generate_views(const idl_pstate_t *pstate, struct generator *generator);
+
 #endif /* GENERATOR_H */
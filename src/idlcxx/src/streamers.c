@@ -93,7 +93,8 @@ enum instance_mask {
   SEQUENCE          = 0x1 << 2,
   ARRAY             = 0x1 << 3,
   OPTIONAL          = 0x1 << 4,
-  EXTERNAL          = 0x1 << 5
+  EXTERNAL          = 0x1 << 5,
+  STRAIGHT_LINE     = 0x1 << 6
 };
 
 struct instance_location {
@@ -128,6 +129,7 @@ struct streams {
   idl_buffer_t move;
   idl_buffer_t max;
   idl_buffer_t props;
+  size_t cases_start;
 };
 
 static void setup_streams(struct streams* str, struct generator* gen)
@@ -346,16 +348,23 @@ write_constructed_type_streaming_functions(
   struct streams* streams,
   const idl_type_spec_t* type_spec,
   const char* accessor,
-  const char* read_accessor)
+  const char* read_accessor,
+  instance_location_t loc)
 {
   char *type = NULL;
-  static const char* fmt =
+  const char* fmt =
     "      {\n"
     "        const auto *subprops = prop->first_member ? prop : get_type_props<%1$s>().data();\n"
     "        if (!{T}(streamer, %2$s, subprops))\n"
     "          return false;\n"
     "      }\n";
 
+  //the straight-line path has no member properties, so it uses the root of the type's own tree
+  if (loc.type & STRAIGHT_LINE)
+    fmt =
+      "      if (!{T}(streamer, %2$s, get_type_props<%1$s>().data()))\n"
+      "        return false;\n";
+
   if (IDL_PRINTA(&type, get_cpp11_fully_scoped_name, type_spec, streams->generator) < 0)
     return IDL_RETCODE_NO_MEMORY;
 
@@ -369,12 +378,26 @@ write_constructed_type_streaming_functions(
 static idl_retcode_t
 write_union_streaming_functions(
   struct streams* streams,
+  const idl_type_spec_t* type_spec,
   const char* accessor,
-  const char* read_accessor)
+  const char* read_accessor,
+  instance_location_t loc)
 {
   static const char* fmt =
     "      if (!{T}(streamer, %1$s, prop))\n"
     "        return false;\n";
+  static const char* sfmt =
+    "      if (!{T}(streamer, %1$s, get_type_props<%2$s>().data()))\n"
+    "        return false;\n";
+
+  if (loc.type & STRAIGHT_LINE) {
+    char *type = NULL;
+    if (IDL_PRINTA(&type, get_cpp11_fully_scoped_name, type_spec, streams->generator) < 0
+     || multi_putf(streams, CONST, sfmt, accessor, type)
+     || multi_putf(streams, READ, sfmt, read_accessor, type))
+      return IDL_RETCODE_NO_MEMORY;
+    return IDL_RETCODE_OK;
+  }
 
   if (multi_putf(streams, CONST, fmt, accessor)
    || multi_putf(streams, READ, fmt, read_accessor))
@@ -441,9 +464,9 @@ write_streaming_functions(
   } else if (idl_is_string(type_spec)) {
     return write_string_streaming_functions(streams, type_spec, accessor, read_accessor);
   } else if (idl_is_struct(type_spec)) {
-    return write_constructed_type_streaming_functions(streams, type_spec, accessor, read_accessor);
+    return write_constructed_type_streaming_functions(streams, type_spec, accessor, read_accessor, loc);
   } else if (idl_is_union(type_spec)) {
-    return write_union_streaming_functions(streams, accessor, read_accessor);
+    return write_union_streaming_functions(streams, type_spec, accessor, read_accessor, loc);
   } else {
     return write_base_type_streaming_functions(streams, type_spec, accessor, read_accessor, loc);
   }
@@ -469,12 +492,16 @@ sequence_writes(const idl_pstate_t* pstate,
 {
   const idl_type_spec_t *type_spec = seq->type_spec;
 
-  if ((idl_is_base_type(type_spec) || idl_is_enum(type_spec))
-    && (idl_mask(type_spec) & IDL_BOOL) != IDL_BOOL) {
+  if (idl_is_base_type(type_spec) || idl_is_enum(type_spec)) {
 
     const char* sfmt = "      if (se_%2$u > 0 &&\n"
                        "          !{T}(streamer, %1$s[0], se_%2$u))\n"
                        "        return false;\n";
+    /*sequences of booleans are not necessarily contiguous in memory (std::vector<bool>)*/
+    if ((idl_mask(type_spec) & IDL_BOOL) == IDL_BOOL)
+      sfmt = "      if (se_%2$u > 0 &&\n"
+             "          !{T}_bool_sequence(streamer, %1$s, se_%2$u))\n"
+             "        return false;\n";
     const char* mfmt = "      %3$s\n"
                        "      if (se_%2$u > 0 &&\n"
                        "          !{T}(streamer, %1$s(), se_%2$u))\n"
@@ -1165,8 +1192,7 @@ print_constructed_type_open(struct streams *streams, const idl_node_t *node)
   static const char *fmt =
     "template<typename T, std::enable_if_t<std::is_base_of<cdr_stream, T>::value, bool> = true >\n"
     "bool {T}(T& streamer, {C}%1$s& instance, const entity_properties_t *props) {\n"
-    "  (void)instance;\n"
-    "  member_id_set member_ids;\n";
+    "  (void)instance;\n";
   static const char *pfmt1 =
     "template<>\n"
     "const propvec &get_type_props<%s>()%s";
@@ -1182,10 +1208,6 @@ print_constructed_type_open(struct streams *streams, const idl_node_t *node)
     "  if (initialized.load(std::memory_order_relaxed))\n"
     "    return props;\n"
     "  props.clear();\n\n";
-  static const char *sfmt =
-    "  if (!streamer.start_struct(*props))\n"
-    "    return false;\n";
-
 
   const char *ext = NULL;
   switch (get_extensibility(node)) {
@@ -1205,13 +1227,26 @@ print_constructed_type_open(struct streams *streams, const idl_node_t *node)
   if (multi_putf(streams, ALL, fmt, name)
    || putf(&streams->props, pfmt1, name, pfmt2)
    || idl_fprintf(streams->generator->header.handle, pfmt1, name, ";\n\n") < 0
-   || multi_putf(streams, ALL, sfmt)
    || putf(&streams->props, "  props.push_back(entity_properties_t(0, 0, false, bit_bound::bb_unset, extensibility::%1$s));  //root\n", ext))
     return IDL_RETCODE_NO_MEMORY;
 
   return IDL_RETCODE_OK;
 }
 
+static idl_retcode_t
+print_constructed_type_start(struct streams *streams, uint32_t n_members)
+{
+  static const char *fmt =
+    "  member_id_set_n<%1$"PRIu32"> member_ids;\n"
+    "  if (!streamer.start_struct(*props))\n"
+    "    return false;\n";
+
+  if (multi_putf(streams, ALL, fmt, n_members))
+    return IDL_RETCODE_NO_MEMORY;
+
+  return IDL_RETCODE_OK;
+}
+
 static idl_retcode_t
 print_switchbox_open(struct streams *streams)
 {
@@ -1298,6 +1333,151 @@ print_entry_point_functions(
 return IDL_RETCODE_OK;
 }
 
+static idl_retcode_t
+print_read_member_function(
+  struct streams *streams,
+  const char *fullname,
+  const char *cases,
+  uint32_t n_members)
+{
+  /* reads a single member at the current position of the stream, this is used by the generated
+     views to decode only the members which are accessed */
+  static const char *fmt =
+    "template<typename T, std::enable_if_t<std::is_base_of<cdr_stream, T>::value, bool> = true >\n"
+    "bool read_member(T& streamer, %1$s& instance, const entity_properties_t *prop) {\n"
+    "  (void)instance;\n"
+    "  member_id_set_n<%2$"PRIu32"> member_ids;\n"
+    "  switch (prop->m_id) {\n"
+    "%3$s"
+    "      default:\n"
+    "        return false;\n"
+    "  }\n"
+    "  return true;\n"
+    "}\n\n";
+
+  if (putf(&streams->read, fmt, fullname, n_members, cases))
+    return IDL_RETCODE_NO_MEMORY;
+
+  return IDL_RETCODE_OK;
+}
+
+static uint32_t
+count_struct_members(const idl_struct_t *_struct)
+{
+  uint32_t n_members = 0;
+  const idl_struct_t *base = _struct;
+  while (base) {
+    const idl_member_t *member = NULL;
+    IDL_FOREACH(member, base->members) {
+      const idl_declarator_t *declarator = NULL;
+      IDL_FOREACH(declarator, member->declarators) {
+        n_members++;
+      }
+    }
+    base = base->inherit_spec ? (const idl_struct_t *)(base->inherit_spec->base) : NULL;
+  }
+
+  return n_members;
+}
+
+static bool
+has_straight_line_path(const idl_struct_t *_struct)
+{
+  if (get_extensibility(_struct) != IDL_FINAL)
+    return false;
+
+  //optional members need headers or presence flags, which are only handled by the member hooks
+  const idl_struct_t *base = _struct;
+  while (base) {
+    const idl_member_t *member = NULL;
+    IDL_FOREACH(member, base->members) {
+      if (is_optional(member))
+        return false;
+    }
+    base = base->inherit_spec ? (const idl_struct_t *)(base->inherit_spec->base) : NULL;
+  }
+
+  return true;
+}
+
+static idl_retcode_t
+process_member_straight_line(
+  const idl_pstate_t* pstate,
+  const idl_member_t *mem,
+  struct streams *streams)
+{
+  const idl_declarator_t *declarator = NULL;
+  const idl_type_spec_t *type_spec = mem->type_spec;
+  static const char *scope_start =
+    "      streamer.start_member_scope();\n";
+  static const char *scope_finish =
+    "      streamer.finish_member_scope();\n";
+
+  IDL_FOREACH(declarator, mem->declarators) {
+    instance_location_t loc = {.parent = "instance", .type = STRAIGHT_LINE};
+    //arrays (also through typedefs) need to know they are at the start of a member
+    bool scoped = idl_is_array(declarator) || idl_is_alias(type_spec);
+
+    if (is_external(mem)) {
+      char *accessor = NULL, *type = NULL;
+      const idl_type_spec_t *ext_type_spec = idl_is_array(declarator) ? (const idl_type_spec_t *)declarator : type_spec;
+      if (IDL_PRINTA(&accessor, get_instance_accessor, declarator, &loc) < 0
+       || IDL_PRINTA(&type, get_cpp11_type, ext_type_spec, streams->generator) < 0
+       || multi_putf(streams, READ, "      if (!%1$s)\n"
+                                    "        %1$s = std::make_shared<%2$s>();\n", accessor, type)
+       || multi_putf(streams, (WRITE|MOVE), "      if (!%1$s)\n"
+                                            "        return false;\n", accessor))
+        return IDL_RETCODE_NO_MEMORY;
+      loc.type |= EXTERNAL;
+    }
+
+    if ((scoped && multi_putf(streams, ALL, scope_start))
+     || process_entity(pstate, streams, declarator, type_spec, loc)
+     || (scoped && multi_putf(streams, ALL, scope_finish)))
+      return IDL_RETCODE_NO_MEMORY;
+  }
+
+  return IDL_RETCODE_OK;
+}
+
+static idl_retcode_t
+print_straight_line_path(
+  const idl_pstate_t* pstate,
+  const idl_struct_t *_struct,
+  struct streams *streams)
+{
+  /* final types without optional members are streamed in declaration order, without looking up
+     member properties or calling the member hooks, key streams still go through the switchbox
+     as they only contain (and may reorder) the key members */
+  if (multi_putf(streams, ALL, "  if (!streamer.is_key()) {\n"))
+    return IDL_RETCODE_NO_MEMORY;
+
+  size_t to_unroll = 1;
+  const idl_struct_t *base = _struct;
+  while (base->inherit_spec) {
+    base =  (const idl_struct_t *)(base->inherit_spec->base);
+    to_unroll++;
+  }
+
+  do {
+    size_t depth_to_go = --to_unroll;
+    base = _struct;
+    while (depth_to_go--)
+      base =  (const idl_struct_t *)(base->inherit_spec->base);
+
+    const idl_member_t *member = NULL;
+    IDL_FOREACH(member, base->members) {
+      if (process_member_straight_line(pstate, member, streams))
+        return IDL_RETCODE_NO_MEMORY;
+    }
+  } while (to_unroll);
+
+  if (multi_putf(streams, ALL, "    return true;\n  }\n"))
+    return IDL_RETCODE_NO_MEMORY;
+
+  return IDL_RETCODE_OK;
+}
+
 static idl_retcode_t
 process_struct_contents(
   const idl_pstate_t* pstate,
@@ -1356,18 +1536,42 @@ process_struct(
     return IDL_RETCODE_NO_MEMORY;
 
   if (revisit) {
+    /* the cases of the switchbox are reused for reading single members */
+    char *cases = NULL;
+    bool views = streams->generator->generate_views && !is_nested(node);
+    if (views) {
+      assert(streams->cases_start <= streams->read.used);
+      size_t len = streams->read.used - streams->cases_start;
+      if (!(cases = malloc(len + 1)))
+        return IDL_RETCODE_NO_MEMORY;
+      memcpy(cases, streams->read.data + streams->cases_start, len);
+      cases[len] = '\0';
+    }
+
+    idl_retcode_t ret = IDL_RETCODE_OK;
     if (print_switchbox_close(user_data)
      || print_constructed_type_close(user_data, node)
-     || (!is_nested(node) && print_entry_point_functions(streams, fullname)))
-      return IDL_RETCODE_NO_MEMORY;
+     || (!is_nested(node) && print_entry_point_functions(streams, fullname))
+     || (views && print_read_member_function(streams, fullname, cases, count_struct_members(node))))
+      ret = IDL_RETCODE_NO_MEMORY;
+
+    if (cases)
+      free(cases);
+    if (ret)
+      return ret;
 
     return flush(streams->generator, streams);
   } else {
 
     idl_retcode_t ret = IDL_RETCODE_OK;
     if ((ret = print_constructed_type_open(user_data, node))
-     || (ret = print_switchbox_open(user_data))
-     || (ret = process_struct_contents(pstate, revisit, path, node, streams)))
+     || (has_straight_line_path(node) && (ret = print_straight_line_path(pstate, node, streams)))
+     || (ret = print_constructed_type_start(user_data, count_struct_members(node)))
+     || (ret = print_switchbox_open(user_data)))
+      return ret;
+
+    streams->cases_start = streams->read.used;
+    if ((ret = process_struct_contents(pstate, revisit, path, node, streams)))
       return ret;
 
     return IDL_VISIT_REVISIT;
@@ -1433,7 +1637,8 @@ process_union(
 
     return flush(streams->generator, streams);
   } else {
-    if (print_constructed_type_open(user_data, node))
+    if (print_constructed_type_open(user_data, node)
+     || print_constructed_type_start(user_data, 0))
       return IDL_RETCODE_NO_MEMORY;
     return IDL_VISIT_REVISIT;
   }
@@ -1482,8 +1687,7 @@ process_typedef_decl(
   static const char* fmt =
     "template<typename T, std::enable_if_t<std::is_base_of<cdr_stream, T>::value, bool> = true >\n"
     "bool {T}_%1$s(T& streamer, {C}%2$s& instance) {\n"
-    "  (void)instance;\n"
-    "  member_id_set member_ids;\n";
+    "  (void)instance;\n";
   char* name = NULL;
   if (IDL_PRINTA(&name, get_cpp11_name_typedef, declarator, streams->generator) < 0)
     return IDL_RETCODE_NO_MEMORY;
@@ -1553,7 +1757,8 @@ process_enum(
   const char *enum_name = NULL;
   idl_retcode_t ret = IDL_RETCODE_OK;
   uint32_t *already_encountered = NULL,
-           n = 0;
+           n = 0,
+           max_value = 0;
 
   (void)pstate;
   (void)revisit;
@@ -1566,7 +1771,9 @@ process_enum(
   static const char *conv_func = "template<>\n"\
                     "%s enum_conversion<%s>(uint32_t in)%s",
                     *bb_func = "template<>\n"\
-                    "constexpr bit_bound get_bit_bound<%s>() { return bit_bound::bb_%d_bits; }\n\n";
+                    "constexpr bit_bound get_bit_bound<%s>() { return bit_bound::bb_%d_bits; }\n\n",
+                    *bound_func = "template<>\n"\
+                    "constexpr uint32_t enum_bound<%s>() { return %"PRIu32"; }\n\n";
 
   if (putf(&str->props, conv_func, fullname, fullname, " {\n  switch (in) {\n")
    || idl_fprintf(gen->header.handle, conv_func, fullname, fullname, ";\n\n") < 0)
@@ -1596,6 +1803,8 @@ process_enum(
       continue;
 
     already_encountered[n++] = value;
+    if (value > max_value)
+      max_value = value;
 
     if (putf(&str->props, "    %scase %"PRIu32":\n"
                           "    return %s::%s;\n"
@@ -1612,6 +1821,9 @@ process_enum(
   //generate entity properties function for enums
   if (putf(&str->props,"  }\n}\n\n")) {
     ret = IDL_RETCODE_NO_MEMORY;
+  } else if (n && max_value == n - 1 /*the distinct values are exactly 0 .. n-1*/
+          && idl_fprintf(gen->header.handle, bound_func, fullname, n) < 0) {
+    ret = IDL_RETCODE_NO_MEMORY;
   } else if (_enum->bit_bound.annotation) {
     int bb = 32;
     if (_enum->bit_bound.value > 32)
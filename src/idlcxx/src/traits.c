@@ -9,6 +9,7 @@
 // SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
 
 #include <string.h>
+#include <inttypes.h>
 
 #include "idl/stream.h"
 #include "idl/processor.h"
@@ -86,6 +87,177 @@ emit_isKeyless(
   }
 }
 
+#define KEY_SIZE_UNKNOWN SIZE_MAX
+#define KEY_SIZE_LIMIT UINT16_MAX
+
+static size_t
+key_align(size_t pos, size_t alignment)
+{
+  return (pos + alignment - 1) & ~(alignment - 1);
+}
+
+static size_t
+key_members_max_size(const idl_struct_t *_struct, size_t pos);
+
+/* the position after count instances of type_spec, written as part of the key in a big endian basic
+   cdr stream from pos onwards, as is done for the keyhash */
+static size_t
+key_type_max_size(const idl_type_spec_t *type_spec, uint32_t count, size_t pos)
+{
+  size_t size;
+
+  type_spec = idl_strip(type_spec, IDL_STRIP_ALIASES | IDL_STRIP_FORWARD);
+  if (idl_is_array(type_spec))
+    return KEY_SIZE_UNKNOWN;
+
+  if (idl_is_enum(type_spec)) {
+    size = 4; /* enums are written as 32-bit integers in basic cdr */
+  } else if (idl_is_base_type(type_spec)) {
+    switch (idl_type(type_spec)) {
+      case IDL_CHAR: case IDL_BOOL: case IDL_INT8: case IDL_UINT8: case IDL_OCTET:
+        size = 1; break;
+      case IDL_SHORT: case IDL_USHORT: case IDL_INT16: case IDL_UINT16:
+        size = 2; break;
+      case IDL_LONG: case IDL_ULONG: case IDL_INT32: case IDL_UINT32: case IDL_FLOAT:
+        size = 4; break;
+      case IDL_LLONG: case IDL_ULLONG: case IDL_INT64: case IDL_UINT64: case IDL_DOUBLE:
+        size = 8; break;
+      default:
+        return KEY_SIZE_UNKNOWN;
+    }
+  } else if (idl_is_string(type_spec) && idl_is_bounded(type_spec)) {
+    /* length field, characters and terminating zero */
+    const size_t max_chars = ((const idl_string_t *)type_spec)->maximum;
+    for (uint32_t i = 0; i < count && pos <= KEY_SIZE_LIMIT; i++)
+      pos = key_align(pos, 4) + 4 + max_chars + 1;
+    return pos <= KEY_SIZE_LIMIT ? pos : KEY_SIZE_UNKNOWN;
+  } else if (idl_is_struct(type_spec)) {
+    for (uint32_t i = 0; i < count && pos <= KEY_SIZE_LIMIT; i++)
+      pos = key_members_max_size(type_spec, pos);
+    return pos <= KEY_SIZE_LIMIT ? pos : KEY_SIZE_UNKNOWN;
+  } else {
+    return KEY_SIZE_UNKNOWN;
+  }
+
+  if (count > KEY_SIZE_LIMIT)
+    return KEY_SIZE_UNKNOWN;
+  pos = key_align(pos, size) + size * count;
+  return pos <= KEY_SIZE_LIMIT ? pos : KEY_SIZE_UNKNOWN;
+}
+
+/* the position after the key members of _struct, which are written in member id order, if none of
+   its members are keys, all members are part of the key */
+static size_t
+key_members_max_size(const idl_struct_t *_struct, size_t pos)
+{
+  const idl_member_t *member = NULL;
+  const idl_declarator_t *declarator = NULL;
+  bool has_keys = false;
+  uint32_t last_id = 0;
+  bool first = true;
+
+  /* keys of derived types and mutable types are left to the runtime */
+  if (_struct->inherit_spec || get_extensibility(_struct) == IDL_MUTABLE)
+    return KEY_SIZE_UNKNOWN;
+
+  IDL_FOREACH(member, _struct->members) {
+    if (member->key.value)
+      has_keys = true;
+  }
+
+  for (;;) {
+    const idl_member_t *next_member = NULL;
+    const idl_declarator_t *next = NULL;
+
+    IDL_FOREACH(member, _struct->members) {
+      if (has_keys && !member->key.value)
+        continue;
+      IDL_FOREACH(declarator, member->declarators) {
+        uint32_t id = declarator->id.value;
+        if ((first || id > last_id) && (!next || id < next->id.value)) {
+          next_member = member;
+          next = declarator;
+        }
+      }
+    }
+
+    if (!next)
+      return pos;
+    if (is_optional(next_member) || is_external(next_member))
+      return KEY_SIZE_UNKNOWN;
+
+    uint32_t count = 1;
+    if (idl_is_array(next)) {
+      const idl_literal_t *dim = (const idl_literal_t *)next->const_expr;
+      for (; dim; dim = idl_next(dim)) {
+        if (dim->value.uint32 > KEY_SIZE_LIMIT / count)
+          return KEY_SIZE_UNKNOWN;
+        count *= dim->value.uint32;
+      }
+    }
+
+    pos = key_type_max_size(next_member->type_spec, count, pos);
+    if (pos == KEY_SIZE_UNKNOWN)
+      return KEY_SIZE_UNKNOWN;
+    last_id = next->id.value;
+    first = false;
+  }
+}
+
+static bool
+key_members_readable(const idl_struct_t *_struct, bool last);
+
+/* whether type_spec is read in the same way from a serialized key as from a serialized sample */
+static bool
+key_type_readable(const idl_type_spec_t *type_spec)
+{
+  type_spec = idl_strip(type_spec, IDL_STRIP_ALIASES | IDL_STRIP_FORWARD);
+  if (idl_is_array(type_spec))
+    return false;
+  if (idl_is_base_type(type_spec) || idl_is_enum(type_spec) || idl_is_bitmask(type_spec) || idl_is_string(type_spec))
+    return true;
+  if (idl_is_sequence(type_spec))
+    return key_type_readable(((const idl_sequence_t *)type_spec)->type_spec);
+  if (idl_is_struct(type_spec))
+    return key_members_readable(type_spec, false);
+  return false;
+}
+
+/* whether reading the key members of _struct from a serialized sample, as if it were a serialized
+   key, reads its key; this is the case if the key members precede the other members, or if all
+   members are delimited, as in mutable types; if more of the sample is read after _struct (!last),
+   all its members need to be part of the key, as nothing is skipped at the end of a final type */
+static bool
+key_members_readable(const idl_struct_t *_struct, bool last)
+{
+  const idl_member_t *member = NULL;
+  const bool delimited = get_extensibility(_struct) == IDL_MUTABLE;
+  bool has_keys = false, in_keys = true;
+
+  if (_struct->inherit_spec)
+    return false;
+
+  IDL_FOREACH(member, _struct->members) {
+    if (member->key.value)
+      has_keys = true;
+  }
+
+  IDL_FOREACH(member, _struct->members) {
+    if (has_keys && !member->key.value) {
+      if (!delimited && !last)
+        return false;
+      in_keys = false;
+      continue;
+    }
+    if ((!delimited && !in_keys)
+     || is_optional(member) || is_external(member)
+     || !key_type_readable(member->type_spec))
+      return false;
+  }
+
+  return true;
+}
+
 static idl_retcode_t
 emit_traits(
   const idl_pstate_t* pstate,
@@ -117,6 +289,21 @@ emit_traits(
     "{\n"
     "  return false;\n"
     "}\n\n";
+  static const char *keysizefmt =
+    "template <> constexpr size_t TopicTraits<%1$s>::keyMaxSize()\n"
+    "{\n"
+    "  return %2$"PRIu32";\n"
+    "}\n\n";
+  static const char *keyreadablefmt =
+    "template <> constexpr bool TopicTraits<%1$s>::isKeyReadableFromData()\n"
+    "{\n"
+    "  return true;\n"
+    "}\n\n";
+  static const char *recyclablefmt =
+    "template <> constexpr bool TopicTraits<%1$s>::isRecyclable()\n"
+    "{\n"
+    "  return true;\n"
+    "}\n\n";
   static const char *datarepsfmt =
     "template <> constexpr allowable_encodings_t TopicTraits<%1$s>::allowableEncodings()\n"
     "{\n"
@@ -166,9 +353,22 @@ emit_traits(
       idl_fprintf(gen->header.handle, selfcontainedfmt, name) < 0)
     return IDL_RETCODE_NO_MEMORY;
 
-  if (emit_isKeyless(pstate, node) &&
-      idl_fprintf(gen->header.handle, keylessfmt, name) < 0)
+  if (is_recyclable(node) &&
+      idl_fprintf(gen->header.handle, recyclablefmt, name) < 0)
     return IDL_RETCODE_NO_MEMORY;
+
+  if (emit_isKeyless(pstate, node)) {
+    if (idl_fprintf(gen->header.handle, keylessfmt, name) < 0)
+      return IDL_RETCODE_NO_MEMORY;
+  } else if (idl_is_struct(node) && !(pstate->config.flags & IDL_FLAG_KEYLIST)) {
+    size_t key_size = key_members_max_size(node, 0);
+    if (key_size != KEY_SIZE_UNKNOWN &&
+        idl_fprintf(gen->header.handle, keysizefmt, name, (uint32_t)key_size) < 0)
+      return IDL_RETCODE_NO_MEMORY;
+    if (key_members_readable(node, true) &&
+        idl_fprintf(gen->header.handle, keyreadablefmt, name) < 0)
+      return IDL_RETCODE_NO_MEMORY;
+  }
   if (idl_xcdr2_is_default(node) &&
       idl_fprintf(gen->header.handle, defaultxcdr2fmt, name) < 0)
     return IDL_RETCODE_NO_MEMORY;
@@ -0,0 +1,312 @@
+// Copyright(c) 2024 ZettaScale Technology and others
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Eclipse Distribution License
+// v. 1.0 which is available at
+// http://www.eclipse.org/org/documents/edl-v10.php.
+//
+// SPDX-License-Identifier: EPL-2.0 OR BSD-3-Clause
+
+#include <assert.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "idl/stream.h"
+#include "idl/processor.h"
+#include "idl/print.h"
+
+#include "generator.h"
+
+struct view_members {
+  struct generator *generator;
+  uint32_t index;
+  uint32_t fixed_prefix;
+  bool in_prefix;
+};
+
+/* members of which the serialized size does not depend on their contents */
+static bool
+is_fixed_size(const idl_type_spec_t *type_spec)
+{
+  type_spec = idl_strip(type_spec, IDL_STRIP_ALIASES | IDL_STRIP_ALIASES_ARRAY | IDL_STRIP_FORWARD);
+  return idl_is_base_type(type_spec) || idl_is_enum(type_spec) || idl_is_bitmask(type_spec);
+}
+
+/* final types without optional members are read member after member, without member headers,
+   so each member can be read by itself once its offset is known */
+static bool
+is_lazily_decodable(const idl_struct_t *_struct)
+{
+  if (get_extensibility(_struct) != IDL_FINAL)
+    return false;
+
+  const idl_struct_t *base = _struct;
+  while (base) {
+    const idl_member_t *member = NULL;
+    IDL_FOREACH(member, base->members) {
+      if (is_optional(member))
+        return false;
+    }
+    base = base->inherit_spec ? (const idl_struct_t *)(base->inherit_spec->base) : NULL;
+  }
+
+  return true;
+}
+
+/* sequences of which the serialized elements are identical to the elements in memory, bool is
+   excluded as std::vector<bool> does not store its elements as an array */
+static const idl_type_spec_t *
+referable_sequence_element(const idl_type_spec_t *type_spec)
+{
+  type_spec = idl_strip(type_spec, IDL_STRIP_ALIASES | IDL_STRIP_FORWARD);
+  if (!idl_is_sequence(type_spec))
+    return NULL;
+  type_spec = idl_strip(((const idl_sequence_t *)type_spec)->type_spec, IDL_STRIP_ALIASES | IDL_STRIP_FORWARD);
+  if (!idl_is_base_type(type_spec) || idl_type(type_spec) == IDL_BOOL || idl_type(type_spec) == IDL_LDOUBLE)
+    return NULL;
+  return type_spec;
+}
+
+static idl_retcode_t
+emit_reference_getter(
+  const idl_struct_t *_struct,
+  const idl_declarator_t *declarator,
+  const idl_type_spec_t *type_spec,
+  uint32_t index,
+  struct generator *gen)
+{
+  const idl_type_spec_t *element;
+  const char *name = get_cpp11_name(declarator);
+  char *owner = NULL, *type = NULL;
+
+  if (IDL_PRINTA(&owner, get_cpp11_fully_scoped_name, _struct, gen) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+
+  if (idl_is_string(idl_strip(type_spec, IDL_STRIP_ALIASES | IDL_STRIP_FORWARD))) {
+    static const char *fmt =
+      "  org::eclipse::cyclonedds::topic::string_view %1$s_view() const { return string_member(%2$"PRIu32", &%3$s::%1$s); }\n";
+    if (idl_fprintf(gen->header.handle, fmt, name, index, owner) < 0)
+      return IDL_RETCODE_NO_MEMORY;
+  } else if ((element = referable_sequence_element(type_spec))) {
+    static const char *fmt =
+      "  org::eclipse::cyclonedds::topic::sequence_view<%4$s> %1$s_view() const { return sequence_member<%4$s>(%2$"PRIu32", &%3$s::%1$s); }\n";
+    if (IDL_PRINTA(&type, get_cpp11_type, element, gen) < 0
+     || idl_fprintf(gen->header.handle, fmt, name, index, owner, type) < 0)
+      return IDL_RETCODE_NO_MEMORY;
+  }
+
+  return IDL_RETCODE_OK;
+}
+
+static idl_retcode_t
+emit_view_members(
+  const idl_struct_t *_struct,
+  struct view_members *members)
+{
+  idl_retcode_t ret;
+  struct generator *gen = members->generator;
+
+  /* members of base types come first, both in the stream and in the member properties */
+  if (_struct->inherit_spec
+   && (ret = emit_view_members((const idl_struct_t *)_struct->inherit_spec->base, members)))
+    return ret;
+
+  const idl_member_t *member = NULL;
+  IDL_FOREACH(member, _struct->members) {
+    const idl_declarator_t *declarator = NULL;
+    IDL_FOREACH(declarator, member->declarators) {
+      const idl_type_spec_t *type_spec;
+      const char *name, *fmt, *eofmt = NULL;
+      char *type = NULL;
+
+      if (idl_is_array(declarator))
+        type_spec = declarator;
+      else
+        type_spec = idl_type_spec(declarator);
+
+      if (IDL_PRINTA(&type, get_cpp11_type, type_spec, gen) < 0)
+        return IDL_RETCODE_NO_MEMORY;
+
+      if (members->in_prefix && !is_optional(member) && !is_external(member) && is_fixed_size(idl_type_spec(declarator)))
+        members->fixed_prefix++;
+      else
+        members->in_prefix = false;
+
+      name = get_cpp11_name(declarator);
+      type_spec = idl_strip(type_spec, IDL_STRIP_ALIASES | IDL_STRIP_FORWARD);
+      if (is_optional(member) || is_external(member)) {
+        fmt = "  const %4$s<%1$s>& %2$s() const { return decoded_member(%3$"PRIu32").%2$s(); }\n";
+        eofmt = is_external(member) ? gen->external_format : gen->optional_format;
+      } else if (idl_is_base_type(type_spec) || idl_is_enum(type_spec)) {
+        fmt = "  %1$s %2$s() const { return decoded_member(%3$"PRIu32").%2$s(); }\n";
+      } else {
+        fmt = "  const %1$s& %2$s() const { return decoded_member(%3$"PRIu32").%2$s(); }\n";
+      }
+
+      if (idl_fprintf(gen->header.handle, fmt, type, name, members->index, eofmt) < 0)
+        return IDL_RETCODE_NO_MEMORY;
+
+      /* strings and sequences of primitives can also be referred to without copying them */
+      if (!is_optional(member) && !is_external(member) && !idl_is_array(declarator)
+       && (ret = emit_reference_getter(_struct, declarator, idl_type_spec(declarator), members->index, gen)))
+        return ret;
+
+      members->index++;
+    }
+  }
+
+  return IDL_RETCODE_OK;
+}
+
+static idl_retcode_t
+emit_view(
+  const idl_pstate_t *pstate,
+  bool revisit,
+  const idl_path_t *path,
+  const void *node,
+  void *user_data)
+{
+  idl_retcode_t ret;
+  struct generator *gen = user_data;
+  const idl_struct_t *_struct = node;
+  struct view_members members = { gen, 0, 0, true };
+  char *fqname = NULL;
+  const char *name, *fmt;
+
+  (void)pstate;
+  (void)revisit;
+  (void)path;
+
+  if (is_nested(node))
+    return IDL_RETCODE_OK;
+
+  name = get_cpp11_name(_struct);
+  if (IDL_PRINTA(&fqname, get_cpp11_fully_scoped_name, node, gen) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+
+  fmt = "class %1$s_view : public org::eclipse::cyclonedds::topic::sample_view<%2$s>\n"
+        "{\n"
+        "public:\n";
+  if (idl_fprintf(gen->header.handle, fmt, name, fqname) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+
+  /* getters, which also determine the number of fixed size members at the start of the type */
+  if ((ret = emit_view_members(_struct, &members)))
+    return ret;
+
+  /* constructor */
+  fmt = "\n"
+        "  explicit %1$s_view(::ddscxx_serdata<%2$s> *sd) :\n"
+        "    org::eclipse::cyclonedds::topic::sample_view<%2$s>(sd, %3$s, %4$"PRIu32") { }\n"
+        "};\n\n";
+  if (idl_fprintf(gen->header.handle, fmt, name, fqname,
+                  is_lazily_decodable(_struct) ? "true" : "false", members.fixed_prefix) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+
+  return IDL_RETCODE_OK;
+}
+
+static idl_retcode_t
+emit_view_traits(
+  const idl_pstate_t *pstate,
+  bool revisit,
+  const idl_path_t *path,
+  const void *node,
+  void *user_data)
+{
+  struct generator *gen = user_data;
+  char *fqname = NULL;
+
+  (void)pstate;
+  (void)revisit;
+  (void)path;
+
+  if (is_nested(node))
+    return IDL_RETCODE_OK;
+
+  if (IDL_PRINTA(&fqname, get_cpp11_fully_scoped_name, node, gen) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+
+  static const char *fmt =
+    "template <>\n"
+    "struct view_traits<%1$s>\n"
+    "{\n"
+    "  typedef %1$s_view type;\n"
+    "};\n\n";
+  if (idl_fprintf(gen->header.handle, fmt, fqname) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+
+  return IDL_RETCODE_OK;
+}
+
+static idl_retcode_t
+emit_module(
+  const idl_pstate_t *pstate,
+  bool revisit,
+  const idl_path_t *path,
+  const void *node,
+  void *user_data)
+{
+  struct generator *gen = user_data;
+  const char *name;
+
+  (void)pstate;
+  (void)path;
+
+  name = get_cpp11_name(node);
+  if (revisit) {
+    if (idl_fprintf(gen->header.handle, "} //namespace %s\n\n", name) < 0)
+      return IDL_RETCODE_NO_MEMORY;
+  } else {
+    if (idl_fprintf(gen->header.handle, "namespace %s\n{\n", name) < 0)
+      return IDL_RETCODE_NO_MEMORY;
+    return IDL_VISIT_REVISIT;
+  }
+
+  return IDL_RETCODE_OK;
+}
+
+idl_retcode_t
+generate_views(const idl_pstate_t *pstate, struct generator *generator)
+{
+  idl_retcode_t ret;
+  idl_visitor_t visitor;
+  const char *sources[] = { NULL, NULL };
+
+  if (fputs("#include \"org/eclipse/cyclonedds/topic/sample_view.hpp\"\n\n", generator->header.handle) < 0)
+    return IDL_RETCODE_NO_MEMORY;
+
+  memset(&visitor, 0, sizeof(visitor));
+  visitor.visit = IDL_MODULE | IDL_STRUCT;
+  visitor.accept[IDL_ACCEPT_MODULE] = &emit_module;
+  visitor.accept[IDL_ACCEPT_STRUCT] = &emit_view;
+  assert(pstate->sources);
+  sources[0] = pstate->sources->path->name;
+  visitor.sources = sources;
+  if ((ret = idl_visit(pstate, pstate->root, &visitor, generator)))
+    return ret;
+
+  if (idl_fprintf(generator->header.handle,
+        "namespace org {\n"
+        "namespace eclipse {\n"
+        "namespace cyclonedds {\n"
+        "namespace topic {\n\n") < 0)
+    return IDL_RETCODE_NO_MEMORY;
+
+  memset(&visitor, 0, sizeof(visitor));
+  visitor.visit = IDL_STRUCT;
+  visitor.accept[IDL_ACCEPT_STRUCT] = &emit_view_traits;
+  visitor.sources = sources;
+  if ((ret = idl_visit(pstate, pstate->root, &visitor, generator)))
+    return ret;
+
+  if (idl_fprintf(generator->header.handle,
+        "} //namespace topic\n"
+        "} //namespace cyclonedds\n"
+        "} //namespace eclipse\n"
+        "} //namespace org\n\n") < 0)
+    return IDL_RETCODE_NO_MEMORY;
+
+  return IDL_RETCODE_OK;
+}